@@ -0,0 +1,113 @@
+/**
+ * @file async_io.h
+ * @brief 异步文件读写头文件
+ * @note 声明按偏移读写文件的异步接口：Linux下通过原始系统调用使用io_uring，
+ *       提交请求后立即返回，调用者在等待完成之前可以继续解析或格式化下一块数据；
+ *       io_uring不可用（内核过旧、被禁用或非Linux系统）时退回到pread/pwrite，提交时即同步完成
+ */
+
+#ifndef ASYNC_IO_H
+#define ASYNC_IO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+
+// 每个文件同时进行的请求数，读写各自双缓冲
+#define ASYNC_IO_SLOTS 2
+
+// 一次写入请求最多包含的缓冲区数，并行保存时每个线程一个
+#define ASYNC_IO_MAX_BUFFERS MAX_LOAD_THREADS
+
+/**
+ * @brief io_uring实例
+ * @note 定义在async_io.c中，外部只通过指针使用
+ */
+typedef struct AsyncRing AsyncRing;
+
+/**
+ * @brief 一个读写请求
+ * @note 请求完成之前，缓冲区必须保持有效且不能修改
+ */
+typedef struct {
+    bool pending;                               // 已提交，尚未由waitAsyncRequest()取回结果
+    bool completed;                             // io_uring已报告完成
+    bool write;                                 // 是否为写入请求
+    int count;                                  // 缓冲区数量
+    char *buffers[ASYNC_IO_MAX_BUFFERS];        // 缓冲区，按顺序首尾相接
+    size_t lengths[ASYNC_IO_MAX_BUFFERS];       // 各缓冲区的字节数
+    uint64_t offset;                            // 文件偏移
+    int64_t result;                             // 完成的字节数，出错时为负的错误码
+} AsyncRequest;
+
+/**
+ * @brief 异步读写的文件
+ * @see openAsyncFile(), closeAsyncFile()
+ */
+typedef struct {
+    int fd;                                     // 文件描述符
+    AsyncRing *ring;                            // io_uring实例，为NULL时使用pread/pwrite
+    AsyncRequest requests[ASYNC_IO_SLOTS];      // 各请求槽
+} AsyncFile;
+
+/**
+ * @brief 准备异步读写
+ * @details 创建一个io_uring实例，失败或runtimeOptions.syncIo为true时改用pread/pwrite
+ * @param async 输出参数，异步读写状态
+ * @param file 已打开的文件，之后只能通过异步接口读写，不能再用stdio读写
+ * @note 读写都按显式偏移进行，不使用也不改变文件的当前位置
+ */
+void openAsyncFile(AsyncFile *async, FILE *file);
+
+/**
+ * @brief 提交读取请求
+ * @param async 异步读写状态
+ * @param slot 请求槽（0到ASYNC_IO_SLOTS - 1），槽中之前的请求必须已取回结果
+ * @param buffer 读取缓冲区
+ * @param size 最多读取的字节数
+ * @param offset 文件偏移
+ * @return 提交成功返回true
+ */
+bool submitAsyncRead(AsyncFile *async, int slot, char *buffer, size_t size, uint64_t offset);
+
+/**
+ * @brief 提交写入请求
+ * @details 把各缓冲区的内容依次写到从offset开始的位置
+ * @param async 异步读写状态
+ * @param slot 请求槽（0到ASYNC_IO_SLOTS - 1），槽中之前的请求必须已取回结果
+ * @param buffers 缓冲区数组
+ * @param lengths 各缓冲区的字节数
+ * @param count 缓冲区数量（1到ASYNC_IO_MAX_BUFFERS）
+ * @param offset 文件偏移
+ * @return 提交成功返回true
+ */
+bool submitAsyncWrite(AsyncFile *async, int slot, char *const buffers[], const size_t lengths[], int count,
+                      uint64_t offset);
+
+/**
+ * @brief 等待请求完成
+ * @param async 异步读写状态
+ * @param slot 请求槽
+ * @return 读取或写入的字节数，出错返回-1；槽中没有请求时返回0
+ * @note 写入只完成一部分时剩余部分同步写完，因此成功时总是返回全部字节数；
+ *       读取返回的字节数小于请求的大小表示已到文件末尾
+ */
+int64_t waitAsyncRequest(AsyncFile *async, int slot);
+
+/**
+ * @brief 结束异步读写
+ * @details 等待尚未完成的请求，释放io_uring实例；不关闭文件
+ * @param async 异步读写状态
+ */
+void closeAsyncFile(AsyncFile *async);
+
+/**
+ * @brief 获取异步读写使用的后端名称
+ * @param async 异步读写状态
+ * @return "io_uring"或"pread/pwrite"
+ */
+const char *getAsyncFileBackend(const AsyncFile *async);
+
+#endif // ASYNC_IO_H
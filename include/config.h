@@ -9,10 +9,28 @@
 
 // 系统配置参数
 // 定义系统中各种实体的数量限制，确保内存使用可控
-#define MAX_STUDENTS 1000           // 最大学生数量 - 系统可以存储的学生记录上限
+#define INITIAL_STUDENT_CAPACITY 64 // 学生存储初始容量 - 学生数组按需倍增扩容，记录数上限仅受可用内存限制
 #define MAX_COURSES 10              // 每个学生最多课程数 - 限制单个学生可选修的课程数量
+#define MAX_COURSE_DICT_SIZE 65535  // 课程字典容量上限 - 不同课程名称的总数，课程编号为16位无符号整数
 #define MAX_USERS 50                // 最大用户数量 - 系统支持的用户账户上限
 #define MAX_LOGIN_ATTEMPTS 3        // 最大登录尝试次数 - 防止暴力破解，超过次数将锁定账户
+#define MAX_LOAD_THREADS 64         // 并行加载最大线程数 - --threads=N允许的上限
+#define PARALLEL_LOAD_MIN_BYTES (4 * 1024 * 1024) // 并行加载文件大小阈值 - 小于此大小的CSV文件始终单线程加载
+#define LOAD_CHUNKS_PER_THREAD 4    // 每个加载线程分到的数据块数 - 多切几块使各线程负载均衡
+#define PARALLEL_SAVE_MIN_ROWS 65536 // 并行保存记录数阈值 - 少于此数的学生数据始终单线程格式化
+#define SAVE_BLOCK_ROWS 16384       // 保存块行数 - 每个线程每轮把这么多行格式化到自己的缓冲区，各块按顺序作为一个异步写入请求提交
+#define MAX_REPORTED_PARSE_ERRORS 20 // 加载时逐条显示的格式错误上限 - 超出部分只计数，避免大文件刷屏
+#define LOAD_PROGRESS_ROWS 4096     // 加载进度更新间隔（行） - 每解析这么多行更新一次已解析字节数
+#define LOAD_PROGRESS_INTERVAL_MS 100 // 加载进度刷新间隔（毫秒） - 等待后台加载时进度显示的刷新周期
+#define STREAM_BUFFER_SIZE (4 * 1024 * 1024) // 流式统计读缓冲区大小 - 逐块读取外部CSV文件，内存占用与文件大小无关
+#define CSV_WRITE_BUFFER_SIZE (4 * 1024 * 1024) // CSV写入缓冲区初始大小 - 保存时每个数据块先格式化到这样大的缓冲区，装不下时倍增
+#define MAX_STREAM_FILES 32         // 流式统计单次最多文件数 - 各文件分别统计后合并
+#define HEAP_BLOCK_ROWS 4096        // 快照校验块行数 - 每块单独计算CRC32C，损坏时只重新解析这些行
+#define JOURNAL_SYNC_RECORDS 16     // 变更日志同步批量 - 未同步的记录达到此数时调用一次fsync
+#define JOURNAL_SYNC_INTERVAL_MS 1000 // 变更日志同步间隔（毫秒） - 距上次fsync超过此时间的记录立即同步
+#define JOURNAL_COMPACT_RECORDS 1000 // 变更日志压缩阈值 - 退出时日志记录数达到此值则完整保存CSV并清空日志，可用--compact=N修改
+#define AUTOSAVE_INTERVAL_MS 2000   // 自动保存间隔（毫秒） - 后台线程每隔此时间把待写入的变更写入日志，可用--autosave=MS修改
+#define AUTOSAVE_CHANGES 16         // 自动保存变更数阈值 - 待写入的变更达到此数时立即唤醒后台线程，可用--autosave-changes=N修改
 
 // 字符串长度限制
 // 定义各种字符串字段的最大长度，防止缓冲区溢出并优化内存分配
@@ -21,6 +39,7 @@
 #define MAX_COURSE_NAME_LENGTH 50   // 课程名称最大长度 - 支持完整的课程名称描述
 #define MAX_USERNAME_LENGTH 30      // 用户名最大长度 - 登录系统使用的用户名
 #define MAX_PASSWORD_LENGTH 30      // 密码最大长度 - 用户密码的字符数限制
+#define MAX_PATH_LENGTH 260         // 文件路径最大长度 - 用户输入的外部文件路径
 
 // 分数相关配置
 // 定义成绩评价体系的分数范围和等级标准
@@ -28,6 +47,8 @@
 #define MAX_SCORE 100.0             // 最高分数 - 成绩的上限值，采用百分制
 #define PASS_SCORE 60.0             // 及格分数 - 判断学生是否通过课程的分数线
 #define EXCELLENT_SCORE 90.0        // 优秀分数 - 判断学生成绩是否优秀的分数线
+#define AVERAGE_CHECK_TOLERANCE 1   // 平均分校验容差（百分之一分） - 加载时兼容不同的四舍五入方式
+#define SCORE_SCALE 100             // 定点成绩比例 - 成绩以百分之一分为单位存储，与CSV中的两位小数一致
 
 // 年龄相关配置
 // 定义学生年龄的合理范围，用于数据验证
@@ -38,6 +59,9 @@
 // 定义系统使用的数据文件和目录路径
 #define STUDENTS_FILE "data/students.csv"   // 学生数据文件 - 存储所有学生信息的CSV格式文件
 #define USERS_FILE "data/users.txt"         // 用户数据文件 - 存储系统用户账户信息
+#define STUDENTS_HEAP_FILE "data/students.heap" // 学生数据二进制快照 - 列式存储，存在时作为默认工作文件
+#define STUDENTS_JOURNAL_FILE "data/students.journal" // 学生数据变更日志 - 增删改逐条追加，启动时在CSV文件或快照之上重放
+#define STUDENTS_QUARANTINE_FILE "data/students_quarantine.csv" // 问题行隔离文件 - 加载时校验未通过的行原样保存在这里
 #define BACKUP_DIR "backup/"                // 备份目录 - 数据备份文件的存储位置
 
 // 菜单选项定义
@@ -65,6 +89,7 @@
 #define STATS_SCORE_DISTRIBUTION 2  // 成绩分布统计 - 显示成绩的分布情况
 #define STATS_SCORE_RANGES 3        // 成绩区间统计 - 按分数段统计学生人数
 #define STATS_OVERALL_ANALYSIS 4    // 综合分析 - 整体成绩趋势和统计信息
+#define STATS_STREAM_ANALYSIS 5     // 流式统计 - 不加载到内存，逐块统计外部CSV文件
 
 // 管理功能菜单选项
 // 系统管理员专用的用户管理功能
@@ -37,6 +37,7 @@ void handleBasicFunctions();
  *       - 成绩分布统计
  *       - 学生排名统计
  *       - 综合统计分析
+ *       - 外部文件流式统计
  */
 void handleStatistics();
 
@@ -0,0 +1,53 @@
+/**
+ * @file course_dict.h
+ * @brief 课程名称字典头文件
+ * @note 声明课程名称与课程编号之间的映射功能，学生记录中只保存课程编号
+ */
+
+#ifndef COURSE_DICT_H
+#define COURSE_DICT_H
+
+#include "types.h"
+
+/**
+ * @brief 登记课程名称
+ * @details 查找课程名称对应的编号，如果字典中不存在则分配新的编号
+ *          编号从0开始连续分配，同一名称始终对应同一编号
+ * @param courseName 课程名称
+ * @return 课程编号，内存不足或字典已满时返回-1
+ * @note 基于开放寻址哈希表，平均时间复杂度O(1)
+ */
+int internCourse(const char *courseName);
+
+/**
+ * @brief 查找课程编号
+ * @details 在字典中查找课程名称对应的编号，不会分配新编号
+ * @param courseName 课程名称
+ * @return 课程编号，未找到时返回-1
+ */
+int findCourseId(const char *courseName);
+
+/**
+ * @brief 获取课程名称
+ * @details 根据课程编号返回课程名称
+ * @param courseId 课程编号
+ * @return 课程名称，编号无效时返回空字符串
+ * @note 返回的指针在字典扩容后可能失效，不要长期保存
+ */
+const char *getCourseName(int courseId);
+
+/**
+ * @brief 获取字典中的课程数量
+ * @return 已登记的课程数量，即有效编号的上界（不包含）
+ * @note 已登记但当前没有学生选修的课程也计算在内
+ */
+int getCourseDictSize();
+
+/**
+ * @brief 释放课程字典
+ * @details 释放字典占用的全部内存，之后的编号全部失效
+ * @note 在系统退出时调用
+ */
+void freeCourseDict();
+
+#endif // COURSE_DICT_H
@@ -0,0 +1,36 @@
+/**
+ * @file crc32c.h
+ * @brief CRC32C校验和头文件
+ * @note 声明CRC32C（Castagnoli多项式）校验和计算功能，用于检查数据文件是否损坏
+ */
+
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief 选择CRC32C计算内核
+ * @details 运行时检测CPU指令集，支持SSE4.2时使用crc32指令，否则使用查表的slicing-by-8实现
+ * @note 多线程计算前应在主线程调用一次；未调用时使用逐位计算的实现，结果相同但速度很慢
+ */
+void initCrc32c();
+
+/**
+ * @brief 获取当前CRC32C内核的名称
+ * @return "SSE4.2"、"slicing-by-8"或"逐位"
+ */
+const char *getCrc32cName();
+
+/**
+ * @brief 计算CRC32C校验和
+ * @details 可以分段计算：把上一段的结果作为crc传入，结果与整段一次计算相同
+ * @param crc 之前各段的校验和，第一段传0
+ * @param data 数据起始地址
+ * @param size 数据字节数
+ * @return 包括本段在内的校验和
+ */
+uint32_t crc32c(uint32_t crc, const void *data, size_t size);
+
+#endif // CRC32C_H
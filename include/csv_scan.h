@@ -0,0 +1,65 @@
+/**
+ * @file csv_scan.h
+ * @brief CSV结构字符扫描器头文件
+ * @note 声明向量化的CSV行扫描功能：一次比较16/32个字节，找出行内的逗号、换行符和引号，
+ *       生成字段偏移索引供记录解析使用；另外提供向量化的UTF-8编码校验
+ */
+
+#ifndef CSV_SCAN_H
+#define CSV_SCAN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "types.h"
+
+/**
+ * @brief 选择扫描内核
+ * @details 运行时检测CPU指令集，依次选用AVX2、SSE2或可移植的SWAR（按64位字并行比较）实现
+ *          UTF-8校验在支持AVX2时使用查表法内核，否则使用逐字符实现
+ * @note 多线程扫描前应在主线程调用一次；未调用时使用SWAR实现，结果相同
+ */
+void initCsvScanner();
+
+/**
+ * @brief 获取当前扫描内核的名称
+ * @return "AVX2"、"SSE2"、"SWAR"或"标量"
+ */
+const char *getCsvScannerName();
+
+/**
+ * @brief 初始化行索引
+ * @param index 要初始化的行索引
+ */
+void initCsvLineIndex(CsvLineIndex *index);
+
+/**
+ * @brief 释放行索引占用的内存
+ * @param index 行索引
+ */
+void freeCsvLineIndex(CsvLineIndex *index);
+
+/**
+ * @brief 扫描一行并建立字段偏移索引
+ * @details 从line开始查找行尾换行符，同时记录行内所有作为分隔符的逗号相对行首的偏移
+ *          双引号括起的部分中的逗号不作为分隔符；行尾的回车符不计入行长度
+ * @param line 行起始位置
+ * @param end 数据结束位置
+ * @param index 输出参数，行索引（复用时覆盖原有内容，容量按需增长）
+ * @param nextLine 输出参数，下一行的起始位置
+ * @return 成功返回true，索引扩容失败（内存不足）返回false
+ * @note 行长度不受限制；第i个字段位于第i-1个和第i个分隔符之间
+ */
+bool indexCsvLine(const char *line, const char *end, CsvLineIndex *index, const char **nextLine);
+
+/**
+ * @brief 校验UTF-8编码
+ * @details 检查数据是否为合法的UTF-8：不允许非法前导字节、缺少或多余的后续字节、
+ *          超长编码、代理区码点以及超过U+10FFFF的码点
+ * @param data 数据起始位置
+ * @param length 数据字节数
+ * @return 合法返回true
+ * @note 支持AVX2时每次检查32个字节，纯ASCII数据几乎没有额外开销
+ */
+bool validateUtf8(const char *data, size_t length);
+
+#endif // CSV_SCAN_H
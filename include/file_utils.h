@@ -8,6 +8,24 @@
 #define FILE_UTILS_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+
+// 原子保存时临时文件的后缀，临时文件与目标文件在同一目录
+#define ATOMIC_TEMP_SUFFIX ".tmp"
+
+/**
+ * @brief 原子保存状态
+ * @details 内容先写入临时文件，提交时再重命名为目标文件
+ * @see openAtomicFile(), commitAtomicFile()
+ */
+typedef struct {
+    FILE *file;                      // 临时文件
+    char target[MAX_PATH_LENGTH];    // 目标文件路径
+    char temp[MAX_PATH_LENGTH];      // 临时文件路径（目标文件路径加ATOMIC_TEMP_SUFFIX）
+} AtomicFile;
 
 // 文件操作函数
 
@@ -33,4 +51,88 @@ bool fileExists(const char* filename);
  */
 bool createDirectory(const char* path);
 
+/**
+ * @brief 获取文件大小和修改时间
+ * @details 使用stat函数读取文件的大小和最后修改时间
+ * @param filename 文件路径
+ * @param size 输出参数，文件大小（字节），可以为NULL
+ * @param modifiedTime 输出参数，最后修改时间（秒），可以为NULL
+ * @return 成功返回true，文件不存在或无法访问时返回false
+ */
+bool getFileInfo(const char* filename, uint64_t* size, int64_t* modifiedTime);
+
+/**
+ * @brief 以只读方式映射整个文件
+ * @details 在Unix/Linux下使用mmap把文件映射到内存，不复制文件内容
+ *          在Windows下退化为把文件整体读入动态分配的缓冲区
+ * @param filename 文件路径
+ * @param size 输出参数，映射的字节数
+ * @return 指向文件内容的指针，文件不存在、为空或映射失败时返回NULL
+ * @note 使用完毕后必须调用unmapFile()释放
+ */
+const void* mapFile(const char* filename, size_t* size);
+
+/**
+ * @brief 释放mapFile()映射的文件
+ * @param data mapFile()返回的指针，为NULL时不做任何操作
+ * @param size mapFile()输出的字节数
+ */
+void unmapFile(const void* data, size_t size);
+
+/**
+ * @brief 把文件内容写入磁盘
+ * @details 先刷新stdio缓冲区，再用fsync（Unix/Linux）或_commit（Windows）等待操作系统写入存储设备
+ * @param file 已打开的文件
+ * @return 成功返回true，否则返回false
+ * @note 返回true后即使断电，已写入的内容也不会丢失
+ */
+bool syncFile(FILE* file);
+
+/**
+ * @brief 截断文件
+ * @details 把文件截断到指定长度，丢弃之后的内容
+ * @param filename 文件路径
+ * @param size 截断后的长度（字节）
+ * @return 成功返回true，文件不存在或无法写入时返回false
+ */
+bool truncateFile(const char* filename, uint64_t size);
+
+/**
+ * @brief 打开原子保存的临时文件
+ * @details 在目标文件所在目录创建"目标文件名.tmp"，之后的内容都写入这个临时文件，目标文件保持不变
+ * @param atomic 输出参数，原子保存状态
+ * @param filename 目标文件路径
+ * @param mode 打开方式，"w"或"wb"
+ * @return 临时文件，路径过长或无法创建时返回NULL
+ * @note 写完后调用commitAtomicFile()替换目标文件，放弃保存时调用abortAtomicFile()
+ */
+FILE* openAtomicFile(AtomicFile* atomic, const char* filename, const char* mode);
+
+/**
+ * @brief 提交原子保存
+ * @details 关闭临时文件并把它重命名为目标文件，重命名是原子的，
+ *          任何时刻崩溃都只会留下完整的旧文件或完整的新文件
+ *          durable为true时先fsync临时文件，再在重命名之后把所在目录记为待同步
+ * @param atomic openAtomicFile()打开的原子保存状态
+ * @param durable 是否需要在断电后保留：可由其他文件重建的数据（如二进制快照）传false，省去fsync
+ * @return 成功返回true；写入、同步或重命名失败时删除临时文件并返回false，目标文件保持不变
+ * @note 目录的fsync推迟到syncPendingDirectory()，同一目录中连续保存的多个文件只同步一次目录
+ */
+bool commitAtomicFile(AtomicFile* atomic, bool durable);
+
+/**
+ * @brief 放弃原子保存
+ * @details 关闭并删除临时文件，目标文件保持不变
+ * @param atomic openAtomicFile()打开的原子保存状态
+ */
+void abortAtomicFile(AtomicFile* atomic);
+
+/**
+ * @brief 同步待同步的目录
+ * @details 对commitAtomicFile()之后尚未同步的目录调用一次fsync，使其中的重命名在断电后也能保留
+ * @return 成功（或没有待同步的目录）返回true，否则返回false
+ * @note 在一组文件保存完毕后调用；删除依赖这些文件的数据（如变更日志）之前也必须调用
+ */
+bool syncPendingDirectory();
+
 #endif // FILE_UTILS_H
\ No newline at end of file
@@ -11,9 +11,11 @@
 #include "types.h"
 
 // 全局变量声明
-extern Student students[MAX_STUDENTS];      // 学生数组
+extern Student *students;                   // 学生数组（动态扩容）
 extern User users[MAX_USERS];               // 用户数组
 extern int studentCount;                    // 当前学生数量
+extern int studentCapacity;                 // 学生数组当前容量
+extern StudentColumns studentColumns;       // 学生成绩列式视图（与学生数组同步）
 extern int userCount;                       // 当前用户数量
 extern char currentUser[MAX_USERNAME_LENGTH]; // 当前登录用户
 extern bool isCurrentUserAdmin;             // 当前用户是否为管理员
@@ -35,4 +37,7 @@ extern int currentSortOrder;               // 当前排序顺序
 // 统计缓存
 extern StatisticsCache statsCache;         // 统计分析缓存
 
+// 运行时选项
+extern RuntimeOptions runtimeOptions;      // 命令行指定的运行时选项
+
 #endif // GLOBALS_H
\ No newline at end of file
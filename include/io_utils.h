@@ -8,6 +8,8 @@
 #define IO_UTILS_H
 
 #include <stdbool.h>
+#include <stdio.h>
+#include "types.h"
 
 // 界面显示函数
 
@@ -83,6 +85,17 @@ int safeInputInt(const char* prompt, int min, int max);
  */
 float safeInputFloat(const char* prompt, float min, float max);
 
+/**
+ * @brief 安全输入成绩
+ * @details 读取用户输入的成绩并直接解析为定点成绩，范围为MIN_SCORE到MAX_SCORE
+ *          循环直到获得有效输入
+ * @param prompt 显示给用户的提示信息
+ * @return 返回用户输入的有效定点成绩（百分之一分）
+ * @note 输入文本按十进制解析，不经过浮点数，第三位小数四舍五入
+ * @see parseScore(), isValidScore()
+ */
+Score safeInputScore(const char *prompt);
+
 /**
  * @brief 安全输入字符串
  * @details 提供安全的字符串输入功能，包含空值检查和自动去除首尾空格
@@ -150,4 +163,36 @@ void printInfo(const char *message);
  */
 char safeInputChar(const char *prompt);
 
+// 后台线程输出暂存函数
+
+/**
+ * @brief 获取当前线程的消息输出流
+ * @details 当前线程调用beginOutputCapture()之后返回其暂存文件，否则返回stdout
+ * @return 消息输出流
+ * @note printSuccess、printError等消息函数都写入此流；可能在后台线程中执行的代码
+ *       输出附加信息时应使用fprintf(messageStream(), ...)而不是printf
+ */
+FILE *messageStream();
+
+/**
+ * @brief 开始暂存当前线程的消息
+ * @details 创建临时文件，之后当前线程写入messageStream()的内容都先存入其中，
+ *          避免后台线程的输出与前台的输入提示交织在一起
+ * @return 成功返回true；临时文件无法创建时返回false，消息照常直接输出
+ */
+bool beginOutputCapture();
+
+/**
+ * @brief 结束暂存当前线程的消息
+ * @return 暂存文件，交给replayCapturedOutput()输出；没有在暂存时返回NULL
+ */
+FILE *endOutputCapture();
+
+/**
+ * @brief 输出暂存的消息
+ * @details 把暂存文件的内容按原顺序写到stdout，然后关闭文件
+ * @param captured endOutputCapture()返回的暂存文件，为NULL时不做任何事
+ */
+void replayCapturedOutput(FILE *captured);
+
 #endif // IO_UTILS_H
\ No newline at end of file
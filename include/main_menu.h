@@ -48,6 +48,7 @@ void displayBasicFunctionsMenu();
  *       2. 成绩分布统计
  *       3. 分数段统计
  *       4. 综合统计分析
+ *       5. 外部文件流式统计
  *       0. 返回主菜单
  */
 void displayStatisticsMenu();
@@ -7,6 +7,14 @@
 #ifndef MATH_UTILS_H
 #define MATH_UTILS_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "types.h"
+
+// 格式化成绩所需的缓冲区长度（足以容纳32位定点数）
+#define SCORE_TEXT_SIZE 16
+
 /**
  * @brief 计算平均值
  * @details 计算浮点数数组的算术平均值
@@ -19,4 +27,84 @@
  */
 float calculateAverage(float scores[], int count);
 
+/**
+ * @brief 定点成绩转换为浮点数
+ * @details 用于显示和需要浮点运算（如标准差）的场合
+ * @param score 定点成绩（百分之一分），也可以是定点总分
+ * @return 对应的分数值
+ */
+float scoreToFloat(int32_t score);
+
+/**
+ * @brief 浮点分数转换为定点成绩
+ * @details 按百分之一分四舍五入
+ * @param value 分数值
+ * @return 定点成绩（百分之一分）
+ */
+int32_t scoreFromFloat(float value);
+
+/**
+ * @brief 解析成绩文本
+ * @details 将"88.5"、"88.50"等十进制文本直接解析为定点成绩，不经过浮点数
+ *          第三位小数四舍五入，允许前后空白（包括行尾换行符）
+ * @param text 成绩文本
+ * @param score 输出参数，解析得到的定点成绩（百分之一分）
+ * @return 格式正确返回true，否则返回false且不修改score
+ * @note 只检查格式，不检查分数范围，范围检查请使用isValidScore()
+ */
+bool parseScore(const char *text, int32_t *score);
+
+/**
+ * @brief 解析指定长度的成绩文本
+ * @details 与parseScore()规则相同，但只读取text开始的length个字节，文本不需要以'\0'结尾
+ * @param text 成绩文本起始地址
+ * @param length 文本字节数
+ * @param score 输出参数，解析得到的定点成绩（百分之一分）
+ * @return 格式正确返回true，否则返回false且不修改score
+ * @note 用于直接解析映射文件中的字段，无需先把字段复制为字符串
+ */
+bool parseScoreSpan(const char *text, size_t length, int32_t *score);
+
+/**
+ * @brief 快速解析CSV成绩字段
+ * @details 专用于数据文件中的成绩格式：非负十进制数，最多两位小数（如"88"、"88.5"、"88.50"）
+ *          不接受正负号、空白、指数和三位以上小数，逐字符直接累加为定点数
+ * @param text 字段起始地址（不需要以'\0'结尾）
+ * @param length 字段字节数
+ * @param score 输出参数，定点成绩（百分之一分）
+ * @return 格式正确返回true，否则返回false且不修改score
+ * @note 只检查格式，范围由调用者根据字段含义检查
+ */
+bool parseScoreField(const char *text, size_t length, int32_t *score);
+
+/**
+ * @brief 快速解析CSV小整数字段
+ * @details 专用于年龄、课程数量等字段：只由数字组成，最多9位
+ * @param text 字段起始地址（不需要以'\0'结尾）
+ * @param length 字段字节数
+ * @param value 输出参数，解析得到的整数
+ * @return 格式正确返回true，否则返回false且不修改value
+ * @note 只检查格式，范围由调用者根据字段含义检查
+ */
+bool parseIntegerField(const char *text, size_t length, int *value);
+
+/**
+ * @brief 格式化定点成绩
+ * @details 将定点成绩格式化为两位小数的文本，输出与printf("%.2f")一致
+ * @param buffer 输出缓冲区，长度至少为SCORE_TEXT_SIZE
+ * @param score 定点成绩（百分之一分），也可以是定点总分
+ * @return 写入的字符数（不含终止符）
+ * @note 只使用整数运算，要求SCORE_SCALE为100
+ */
+int formatScore(char *buffer, int32_t score);
+
+/**
+ * @brief 计算定点平均分
+ * @details 用整数运算计算总分除以课程数的结果，按百分之一分四舍五入
+ * @param total 定点总分
+ * @param count 课程数量
+ * @return 定点平均分，count为0时返回0
+ */
+Score calculateAverageScore(ScoreTotal total, int count);
+
 #endif // MATH_UTILS_H
\ No newline at end of file
@@ -7,6 +7,7 @@
 #ifndef SECURITY_UTILS_H
 #define SECURITY_UTILS_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "config.h"
 
@@ -14,7 +14,7 @@
 /**
  * @brief 显示课程统计信息
  * @details 统计并显示所有课程的详细信息，包括每门课程的人数、最高分、最低分、平均分和及格率
- *          自动收集系统中所有不重复的课程名称，并为每门课程计算统计数据
+ *          按课程字典中的编号一次遍历累计所有课程的统计数据
  * @note 显示内容包括：
  *       - 课程名称
  *       - 选课人数
@@ -60,6 +60,32 @@ void displayStudentRanking();
  */
 void displayOverallStatistics();
 
+// 统计结果输出函数
+
+/**
+ * @brief 输出课程统计表
+ * @details 按课程编号顺序逐行输出课程名称、人数、最高分、最低分、平均分和及格率
+ * @param stats 课程统计数组，按课程编号索引
+ * @param count 数组长度
+ * @note 人数为0的课程（已登记但无人选修）不输出
+ */
+void printCourseStatsTable(const CourseStats *stats, int count);
+
+/**
+ * @brief 输出分数分布
+ * @details 输出各分数段的人数和百分比，以及及格和不及格人数
+ * @param dist 分数分布
+ * @param total 总人数（大于0）
+ */
+void printScoreDistribution(const ScoreDistribution *dist, int total);
+
+/**
+ * @brief 输出总体统计
+ * @details 依次输出学生信息统计、成绩统计和课程统计三部分
+ * @param stats 总体统计（totalStudents大于0）
+ */
+void printOverallStats(const OverallStats *stats);
+
 // 查找功能
 
 /**
@@ -98,16 +124,28 @@ void findTopScoreInCourse();
 /**
  * @brief 计算课程统计信息
  * @details 计算指定课程的详细统计数据，包括选课人数、分数统计和及格率
- * @param courseName 要统计的课程名称
+ * @param courseId 要统计的课程编号（课程字典中的编号）
  * @return CourseStats 包含课程统计信息的结构体
  * @note 统计内容包括：
  *       - studentCount: 选课学生数量
  *       - maxScore, minScore: 最高分和最低分
  *       - totalScore, averageScore: 总分和平均分
  *       - passRate: 及格率（百分比）
+ * @note 按整数编号匹配课程，不做字符串比较
+ * @note 按列投影加载时，调用者须先调用ensureCourseColumns()
  * @warning 如果课程不存在，返回全零的统计结构体
  */
-CourseStats calculateCourseStats(const char* courseName);
+CourseStats calculateCourseStats(int courseId);
+
+/**
+ * @brief 计算所有课程的统计信息
+ * @details 一次遍历所有学生，按课程编号同时累计每门课程的统计数据
+ * @param stats 输出数组，长度至少为getCourseDictSize()，按课程编号索引，调用前需清零
+ * @note 时间复杂度O(学生数×课程数)，与课程种类数无关
+ * @note 按列投影加载时，调用者须先调用ensureCourseColumns()，再按课程字典大小分配stats
+ * @see calculateCourseStats()
+ */
+void calculateAllCourseStats(CourseStats* stats);
 
 /**
  * @brief 计算分数分布
@@ -139,13 +177,14 @@ OverallStats calculateOverallStats();
  * @details 计算指定学生的总分和平均分
  *          根据学生的所有课程成绩计算统计数据
  * @param student 指向要计算统计信息的学生结构体的指针
+ * @param detail 学生详细信息，提供课程成绩
  * @note 计算内容：
  *       - totalScore: 所有课程成绩的总和
  *       - averageScore: 平均成绩（总分/课程数）
  * @note 如果学生没有课程，总分和平均分都设为0
- * @warning 传入的student指针不能为NULL
+ * @warning 传入的student和detail指针不能为NULL
  */
-void calculateStudentStats(Student* student);
+void calculateStudentStats(Student* student, const StudentDetail* detail);
 
 /**
  * @brief 更新全局统计缓存
@@ -170,6 +209,13 @@ void updateGlobalStats();
  */
 void initStatisticsCache();
 
+/**
+ * @brief 释放统计缓存
+ * @details 释放排名缓存占用的动态内存，并将缓存标记为无效
+ * @note 在系统退出时调用
+ */
+void freeStatisticsCache();
+
 /**
  * @brief 检查缓存是否有效
  * @details 检查统计缓存是否仍然有效，通过比较学生数量和数据哈希值
@@ -198,9 +244,41 @@ void invalidateCache();
  * @details 计算当前学生数据的哈希值，用于检测数据变化
  * @return unsigned long 当前数据的哈希值
  * @note 基于学生数量、学号、成绩等关键数据计算哈希值
+ * @note 哈希值为学生数量与各记录哈希值之和，与记录顺序无关，
+ *       因此排序不会使缓存失效，增删改时也可以增量更新
  */
 unsigned long calculateDataHash();
 
+/**
+ * @brief 缓存增量更新：新增学生
+ * @details 在排名缓存中插入新学生，并按差值更新分数分布、总体统计累计值和数据哈希值，不重新扫描全部学生
+ * @param student 新增的学生记录（已加入学生数组）
+ * @param detail 新增学生的详细信息
+ * @note 缓存无效时不做任何操作，下次访问时整体重建
+ */
+void cacheStudentAdded(const Student *student, const StudentDetail *detail);
+
+/**
+ * @brief 缓存增量更新：删除学生
+ * @details 从排名缓存中移除该学生，并按差值更新分数分布、总体统计累计值和数据哈希值，不重新扫描全部学生
+ * @param removed 被删除学生记录的副本（已从学生数组中移除）
+ * @param detail 被删除学生详细信息的副本
+ * @note 缓存无效时不做任何操作，下次访问时整体重建
+ */
+void cacheStudentRemoved(const Student *removed, const StudentDetail *detail);
+
+/**
+ * @brief 缓存增量更新：修改学生
+ * @details 将该学生在排名缓存中重新定位，并按差值更新分数分布、总体统计累计值和数据哈希值，不重新扫描全部学生
+ * @param before 修改前学生记录的副本
+ * @param beforeDetail 修改前详细信息的副本
+ * @param after 修改后的学生记录（列式视图已同步）
+ * @param afterDetail 修改后的详细信息
+ * @note 缓存无效时不做任何操作，下次访问时整体重建
+ */
+void cacheStudentModified(const Student *before, const StudentDetail *beforeDetail,
+                          const Student *after, const StudentDetail *afterDetail);
+
 /**
  * @brief 获取缓存的总体统计
  * @details 获取缓存的总体统计数据，如果缓存无效则先更新缓存
@@ -220,11 +298,11 @@ ScoreDistribution getCachedScoreDistribution();
 /**
  * @brief 获取缓存的学生排名
  * @details 获取缓存的学生排名数据，如果缓存无效则先更新缓存
- * @param rankings 输出参数，存储排名数据的数组
- * @return int 返回排名数据的数量
- * @note 排名按平均分降序排列，优先使用缓存数据
+ * @param rankings 输出参数，指向缓存中的排名数组（只读，缓存更新后失效）
+ * @return int 返回排名数据的数量，缓存不可用时返回0
+ * @note 排名按平均分降序排列，直接返回缓存，避免整表拷贝
  */
-int getCachedStudentRankings(StudentRank* rankings);
+int getCachedStudentRankings(const StudentRank **rankings);
 
 // 排序优化函数
 
@@ -0,0 +1,79 @@
+/**
+ * @file stream_analysis.h
+ * @brief 流式统计分析头文件
+ * @note 声明可合并的统计累加器，以及不把记录加载到学生列表、逐块读取外部CSV文件的流式统计功能
+ *       用于分析超出内存容量的大型成绩档案
+ */
+
+#ifndef STREAM_ANALYSIS_H
+#define STREAM_ANALYSIS_H
+
+#include <stdbool.h>
+#include "types.h"
+
+/**
+ * @brief 初始化统计累加器
+ * @param acc 要初始化的累加器
+ */
+void initStatsAccumulator(StatsAccumulator *acc);
+
+/**
+ * @brief 累计一条学生记录
+ * @details 累计性别、年龄、课程数量、平均分及其平方、分数段人数和各课程成绩
+ * @param acc 累加器
+ * @param student 学生记录
+ * @param detail 学生详细信息
+ * @return 成功返回true，课程累加器扩容失败（内存不足）返回false
+ */
+bool accumulateStudent(StatsAccumulator *acc, const Student *student, const StudentDetail *detail);
+
+/**
+ * @brief 合并统计累加器
+ * @details 把from的结果并入into，结果与把两部分记录累计到同一个累加器相同
+ * @param into 目标累加器
+ * @param from 要并入的累加器（保持不变）
+ * @return 成功返回true，内存不足返回false
+ */
+bool mergeStatsAccumulator(StatsAccumulator *into, const StatsAccumulator *from);
+
+/**
+ * @brief 由累加器得出总体统计
+ * @param acc 累加器
+ * @return 与calculateOverallStats()含义相同的总体统计，没有记录时全部为0
+ * @see calculateOverallStats()
+ */
+OverallStats getAccumulatedOverallStats(const StatsAccumulator *acc);
+
+/**
+ * @brief 由累加器得出分数分布
+ * @param acc 累加器
+ * @return 与calculateScoreDistribution()含义相同的分数分布
+ * @see calculateScoreDistribution()
+ */
+ScoreDistribution getAccumulatedDistribution(const StatsAccumulator *acc);
+
+/**
+ * @brief 由累加器得出各课程统计
+ * @param acc 累加器
+ * @param stats 输出数组，按课程编号索引
+ * @param count 数组长度，通常为getCourseDictSize()
+ * @see calculateAllCourseStats()
+ */
+void getAccumulatedCourseStats(const StatsAccumulator *acc, CourseStats *stats, int count);
+
+/**
+ * @brief 释放统计累加器
+ * @param acc 累加器，释放后可重新初始化使用
+ */
+void freeStatsAccumulator(StatsAccumulator *acc);
+
+/**
+ * @brief 显示外部文件的流式统计
+ * @details 依次输入一个或多个CSV文件路径，每个文件逐块读取一遍并累计到各自的累加器，
+ *          再合并为汇总结果，输出总体统计、分数分布和课程统计
+ * @note 文件中的记录不会加入学生列表，内存占用与文件大小无关
+ * @note 文件格式与STUDENTS_FILE相同；课程名称会登记到课程字典
+ */
+void displayStreamingStatistics();
+
+#endif // STREAM_ANALYSIS_H
@@ -14,10 +14,11 @@
  * @details 交互式地添加新学生信息，包括基本信息和课程成绩
  *          验证学号唯一性、姓名格式、年龄范围等
  *          自动计算总分和平均分
- * @note 会检查学生数量是否已达上限MAX_STUDENTS
+ * @note 学生数组按需扩容，记录数上限仅受可用内存限制
  * @note 学号必须唯一，不能与现有学生重复
- * @warning 如果学生数量已满，会显示错误信息并返回
- * @see MAX_STUDENTS, isValidStudentId(), isValidName()
+ * @note 新记录追加到变更日志，不重写CSV文件
+ * @warning 如果内存不足无法扩容，会显示错误信息并返回
+ * @see appendStudent(), isValidStudentId(), isValidName()
  */
 void addStudent();
 
@@ -30,7 +31,7 @@ void addStudent();
  *       2. 查找并显示学生信息
  *       3. 用户确认删除操作
  *       4. 删除学生并重新排列数组
- *       5. 更新数据修改和统计更新标志
+ *       5. 把删除追加到变更日志，并设置统计更新标志
  * @warning 删除操作不可逆，请谨慎操作
  * @warning 如果没有学生数据，将显示警告信息
  */
@@ -49,6 +50,7 @@ void deleteStudent();
  *       - 修改现有课程成绩
  *       - 添加新课程
  *       - 删除课程
+ * @note 修改后的完整记录追加到变更日志，不重写CSV文件
  * @warning 修改课程信息后会自动重新计算总分和平均分
  */
 void modifyStudent();
@@ -0,0 +1,94 @@
+/**
+ * @file student_heap.h
+ * @brief 学生数据二进制快照头文件
+ * @note 声明学生数据二进制列式快照的保存和恢复功能
+ *       快照存在时作为默认的工作文件，启动时映射文件并校验即可恢复，无需重新解析CSV文本
+ *       学生数据按行分块计算CRC32C，损坏的块从CSV文件中对应的区间重新解析
+ */
+
+#ifndef STUDENT_HEAP_H
+#define STUDENT_HEAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "types.h"
+
+// 快照文件标识和格式版本，布局或头部变化时递增版本号
+// 版本1为按记录存放的内存映像，版本2改为列式布局加字符串表，版本3改为按行分块的CRC32C校验
+#define STUDENT_HEAP_MAGIC "STUHEAP"
+#define STUDENT_HEAP_VERSION 3
+
+// 快照中的数据块编号，每块在文件中的偏移记录在文件头的sectionOffsets中
+#define HEAP_SECTION_AGES 0              // int32_t[学生数]：年龄
+#define HEAP_SECTION_GENDERS 1           // char[学生数]：性别
+#define HEAP_SECTION_COURSE_COUNTS 2     // uint8_t[学生数]：课程数量
+#define HEAP_SECTION_COURSE_IDS 3        // CourseId[学生数 * MAX_COURSES]：课程编号
+#define HEAP_SECTION_SCORES 4            // Score[学生数 * MAX_COURSES]：课程成绩
+#define HEAP_SECTION_TOTALS 5            // ScoreTotal[学生数]：总分
+#define HEAP_SECTION_AVERAGES 6          // Score[学生数]：平均分
+#define HEAP_SECTION_ID_REFS 7           // uint32_t[学生数]：学号在字符串表中的偏移
+#define HEAP_SECTION_NAME_REFS 8         // uint32_t[学生数]：姓名在字符串表中的偏移
+#define HEAP_SECTION_COURSE_NAME_REFS 9  // uint32_t[课程数]：课程名称在字符串表中的偏移
+#define HEAP_SECTION_BLOCKS 10           // StudentHeapBlock[校验块数]：各校验块的校验和与CSV位置
+#define HEAP_SECTION_STRINGS 11          // 字符串表：各行的学号和姓名按行顺序排列，之后是课程名称
+#define HEAP_SECTION_COUNT 12
+
+/**
+ * @brief 快照校验块
+ * @details 每blockRows行学生为一块，块内各列的切片和这些行的学号、姓名字符串一起计算CRC32C
+ *          同时记下这些行在CSV文件中的字节区间，块损坏时只重新解析这一段CSV
+ */
+typedef struct {
+    uint32_t checksum;               // 块内数据的CRC32C
+    uint32_t reserved;               // 保留，填0
+    uint64_t stringOffset;           // 块内各行的字符串在字符串表中的起始偏移
+    uint64_t stringSize;             // 块内各行的字符串字节数
+    uint64_t sourceOffset;           // 块内各行在CSV文件中的起始偏移
+    uint64_t sourceSize;             // 块内各行在CSV文件中的字节数，0表示位置未知
+} StudentHeapBlock;
+
+/**
+ * @brief 学生数据快照文件头
+ * @details 文件布局：文件头 | 各列数据块 | 校验块表 | 字符串表，每个数据块按8字节对齐
+ *          数值列按本机字节序存放，映射文件后把各块偏移加上映射基址即得到列指针
+ * @note 学生数据由各校验块的CRC32C覆盖；文件头（checksum置0）、课程名称和校验块表由checksum覆盖
+ */
+typedef struct {
+    char magic[8];                   // 文件标识STUDENT_HEAP_MAGIC
+    uint32_t version;                // 格式版本STUDENT_HEAP_VERSION
+    uint32_t headerSize;             // sizeof(StudentHeapHeader)
+    int32_t studentCount;            // 学生数量
+    int32_t courseCount;             // 课程字典大小
+    uint32_t maxCourses;             // 写入时的MAX_COURSES，决定课程编号和成绩块的行宽
+    uint32_t blockRows;              // 每个校验块的行数，写入时为HEAP_BLOCK_ROWS
+    uint64_t sourceSize;             // 生成快照时CSV文件的大小
+    int64_t sourceModifiedTime;      // 生成快照时CSV文件的修改时间
+    uint64_t stringTableSize;        // 字符串表字节数
+    uint64_t payloadSize;            // 文件头之后的数据字节数
+    uint64_t checksum;               // 文件头、课程名称和校验块表的CRC32C
+    uint64_t sectionOffsets[HEAP_SECTION_COUNT]; // 各数据块相对文件开头的偏移
+} StudentHeapHeader;
+
+/**
+ * @brief 从二进制快照恢复学生数据
+ * @details 映射STUDENTS_HEAP_FILE，校验文件头、版本和校验和，
+ *          并确认CSV文件在快照生成后没有被修改，然后按列把记录装入学生存储和课程字典
+ *          各校验块的CRC32C由多个线程并行校验，损坏的块从CSV文件中对应的区间重新解析，其余块照常按列恢复
+ * @return 恢复成功返回true；快照不存在、已过期或校验失败时返回false，学生存储保持为空
+ * @note 返回false时调用者应回退到loadStudentsFromFile()
+ * @note 有块被重新解析时会重写快照
+ * @warning 必须在学生存储和课程字典为空时调用
+ */
+bool loadStudentHeap();
+
+/**
+ * @brief 保存二进制快照
+ * @details 把学生存储和课程字典按列写入STUDENTS_HEAP_FILE，并记录当前CSV文件的大小和修改时间
+ *          学生按HEAP_BLOCK_ROWS行分块计算CRC32C，并按学号在CSV文件中找出各块对应的字节区间
+ * @return 保存成功返回true，否则返回false
+ * @note 应在CSV文件保存之后调用，否则下次启动时快照会被判定为过期
+ * @note 先写入临时文件再重命名替换，保存中途崩溃时旧快照保持完整；快照可由CSV文件重建，不调用fsync
+ */
+bool saveStudentHeap();
+
+#endif // STUDENT_HEAP_H
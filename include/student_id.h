@@ -0,0 +1,44 @@
+/**
+ * @file student_id.h
+ * @brief 学号编码键头文件
+ * @note 声明把纯数字学号压缩为64位整数键的编码与比较功能，非数字学号回退为字符串比较
+ */
+
+#ifndef STUDENT_ID_H
+#define STUDENT_ID_H
+
+#include <stdint.h>
+
+// 纯数字学号的最大位数，10^17 - 1 小于 2^57，可以与位数一起放入64位键
+#define STUDENT_KEY_MAX_DIGITS 17
+
+// 数字值所占的位数，更高的位保存学号位数
+#define STUDENT_KEY_LENGTH_SHIFT 59
+
+// 非数字学号（或超过最大位数的学号）的编码键，比较时回退为字符串比较
+#define STUDENT_KEY_NON_NUMERIC UINT64_MAX
+
+/**
+ * @brief 计算学号编码键
+ * @details 纯数字学号编码为 (位数 << 59) | 数值，位数参与编码，因此"007"与"7"得到不同的键
+ *          其他学号统一编码为STUDENT_KEY_NON_NUMERIC
+ * @param studentID 学号字符串
+ * @return 64位学号编码键
+ * @note 键的大小顺序：位数少的数字学号在前，同位数按数值排列（与字符串顺序一致），
+ *       非数字学号排在所有数字学号之后并按字符串排列
+ */
+uint64_t encodeStudentID(const char *studentID);
+
+/**
+ * @brief 比较两个学号
+ * @details 先比较编码键，只有两个学号都是非数字学号时才比较字符串
+ * @param keyA 第一个学号的编码键
+ * @param idA 第一个学号字符串
+ * @param keyB 第二个学号的编码键
+ * @param idB 第二个学号字符串
+ * @return 负数表示A<B，0表示相同，正数表示A>B
+ * @note 数字学号的键相同即表示学号完全相同，只需一次整数比较
+ */
+int compareStudentID(uint64_t keyA, const char *idA, uint64_t keyB, const char *idB);
+
+#endif // STUDENT_ID_H
@@ -7,20 +7,90 @@
 #ifndef STUDENT_IO_H
 #define STUDENT_IO_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "config.h"
+#include "types.h"
+#include "math_utils.h"
+
+// 一条学生记录格式化为CSV数据行所需的缓冲区大小（学号、姓名、年龄等基本字段，各课程名称和成绩，总分和平均分）
+#define STUDENT_RECORD_TEXT_SIZE (MAX_ID_LENGTH + MAX_NAME_LENGTH + 32 + \
+                                  MAX_COURSES * (MAX_COURSE_NAME_LENGTH + SCORE_TEXT_SIZE) + 2 * SCORE_TEXT_SIZE)
 
 /**
  * @brief 从CSV文件加载学生数据
- * @details 从STUDENTS_FILE指定的CSV文件中读取学生信息并加载到内存中
+ * @details 将STUDENTS_FILE映射到内存，用向量化扫描器为每行建立字段索引后直接解析，不经过行缓冲区
  *          解析CSV格式数据，包括学号、姓名、年龄、性别、课程信息等
+ *          大文件按换行符切块后由多个线程并行解析，再按原顺序合并
  *          如果文件不存在，会初始化为空的学生列表
- * @note 会跳过CSV文件的头部行，最多加载MAX_STUDENTS个学生
+ * @note 会跳过CSV文件的头部行，行长度不受限制，同时兼容LF和CRLF换行
+ * @note 学生数组按需扩容，加载完成后收缩到实际记录数，并输出加载吞吐量（MB/s、行/秒）
+ * @note 线程数由--threads=N指定，默认按CPU核数自动选择；加载结果与线程数无关
+ * @note 指定--lazy时只保存统计所需的字段和每条记录的行偏移，文件映射保留到全部记录解码为止，
+ *       姓名和课程明细在显示、修改或导出时才解码
  * @note 加载完成后会设置statsNeedUpdate标志为true
+ * @note 加载时同时校验数据：UTF-8编码、年龄和性别、课程数量、各科成绩的格式和范围，
+ *       以及总分、平均分与各科成绩是否相符；问题按类别汇总并带行号和列号报告，成绩按0处理，
+ *       不符的总分和平均分按各科成绩重新计算，编码无效的行不加载
+ * @note 存在问题的行原样写入STUDENTS_QUARANTINE_FILE；数据全部正常时不改动该文件
+ * @note 指定--columns=时由头部得出各字段的列号，只解析投影包含的字段（姓名始终跳过），
+ *       跳过的字段在首次访问时解码；只加载统计字段时不交叉校验总分和平均分，课程统计前补齐课程列
  * @warning 如果CSV格式不正确，可能导致数据解析错误
- * @see STUDENTS_FILE, MAX_STUDENTS, Student结构体
+ * @see STUDENTS_FILE, STUDENTS_QUARANTINE_FILE, INITIAL_STUDENT_CAPACITY, Student结构体
  */
 void loadStudentsFromFile();
 
+/**
+ * @brief 从CSV数据区间加载学生记录
+ * @details 逐行解析[start, end)中的数据行并追加到学生存储，与loadStudentsFromFile()的单线程解析规则相同
+ * @param start 区间起始位置（行首）
+ * @param end 区间结束位置（行首或数据末尾）
+ * @return 追加的学生数
+ * @note 用于快照损坏时只重新解析受影响的行；数据问题在首次导入时已经报告，这里不再输出
+ */
+int loadStudentsFromRange(const char *start, const char *end);
+
+/**
+ * @brief 初始化格式错误记录
+ * @param log 要清空的错误记录
+ */
+void initCsvErrorLog(CsvErrorLog *log);
+
+/**
+ * @brief 获取CSV加载进度
+ * @details 单线程加载每LOAD_PROGRESS_ROWS行更新一次，并行加载时各线程分别累加自己解析过的字节数
+ * @param done 输出参数，已解析的字节数
+ * @param total 输出参数，待解析的总字节数；尚未开始解析CSV（如正在从快照恢复）时为0
+ * @note 可以在其他线程正在执行loadStudentsFromFile()时调用
+ */
+void getStudentLoadProgress(size_t *done, size_t *total);
+
+/**
+ * @brief 把一条学生记录格式化为CSV数据行
+ * @details 格式与STUDENTS_FILE中的数据行相同：学号、姓名、年龄、性别、课程数量、
+ *          MAX_COURSES组课程名称和成绩（不足的用空值填充）、总分、平均分
+ * @param buffer 输出缓冲区，长度至少为STUDENT_RECORD_TEXT_SIZE
+ * @param size 缓冲区大小
+ * @param student 学生记录
+ * @param detail 学生详细信息
+ * @return 数据行长度（不含换行符），缓冲区不足时返回0
+ * @note 逐字段直接复制和转换数字，不经过printf系列函数；成绩使用整数格式化，不经过浮点数
+ */
+size_t formatStudentRecord(char *buffer, size_t size, const Student *student, const StudentDetail *detail);
+
+/**
+ * @brief 解析一条CSV数据行
+ * @details 与加载STUDENTS_FILE时的解析规则相同，课程名称登记到全局课程字典
+ * @param line 数据行起始位置
+ * @param length 数据行长度（不含换行符）
+ * @param student 输出参数，学生记录（idKey和handle不填写）
+ * @param detail 输出参数，学生详细信息
+ * @return 解析成功返回true；编码无效、字段不足或内存不足时返回false
+ * @note 用于重放变更日志；总分、平均分与各科成绩不符时与加载时一样按各科成绩重新计算
+ */
+bool parseStudentRecord(const char *line, size_t length, Student *student, StudentDetail *detail);
+
 /**
  * @brief 将学生数据保存到CSV文件
  * @details 将内存中的所有学生数据以CSV格式保存到STUDENTS_FILE文件中
@@ -28,9 +98,38 @@ void loadStudentsFromFile();
  *          保存成功后会重置dataModified标志
  * @note CSV格式包括：学号、姓名、年龄、性别、课程数量、各课程名称和成绩、总分、平均分
  * @note 对于课程数量不足MAX_COURSES的学生，会用空值填充
+ * @note 按SAVE_BLOCK_ROWS行分块格式化到内存缓冲区，整块异步写入（io_uring或pwrite），
+ *       写入上一块时格式化下一块；记录较多时由多个线程并行格式化，输出与单线程保存完全相同
+ * @note 延迟加载的记录会先全部解码，再覆盖写入其所在的CSV文件
+ * @note 先写入同一目录的临时文件，fsync后重命名替换STUDENTS_FILE，保存中途崩溃时原文件保持完整
+ * @note 保存成功后清空变更日志STUDENTS_JOURNAL_FILE
  * @warning 如果文件无法创建或写入，会显示错误信息
  * @see STUDENTS_FILE, MAX_COURSES, dataModified
  */
 void saveStudentsToFile();
 
+/**
+ * @brief 流式读取学生CSV文件
+ * @details 以STREAM_BUFFER_SIZE为单位分块异步读取文件（io_uring或pread），解析当前块时下一块已在读取，
+ *          逐行解析后交给visitor处理，记录不保存到学生存储
+ *          块末尾不完整的行移到缓冲区开头，与下一块拼接后再解析
+ * @param filename 文件路径
+ * @param visitor 记录处理函数
+ * @param context 传给visitor的上下文
+ * @param projection 列投影，按文件头部定位需要的字段；投影不包含的字段在交给visitor的记录中为空
+ * @param errors 格式错误记录，行号为文件中的行号
+ * @param rows 输出参数，扫描的数据行数
+ * @return 读完整个文件返回true；文件无法打开、读取出错、内存不足或visitor要求停止时返回false
+ * @note 内存占用只与缓冲区大小和最长的行有关，与文件大小无关；课程名称登记到全局课程字典
+ */
+bool streamStudentsFromFile(const char *filename, StudentVisitor visitor, void *context,
+                            LoadProjection projection, CsvErrorLog *errors, int64_t *rows);
+
+/**
+ * @brief 释放延迟加载保留的CSV文件映射
+ * @details 解除映射并取消学生存储中的解码函数，尚未解码的记录之后按空的详细信息处理
+ * @note 需要保留数据时应先调用materializeAllStudents()；在系统退出时调用
+ */
+void releaseDeferredStudentSource();
+
 #endif // STUDENT_IO_H
\ No newline at end of file
@@ -0,0 +1,79 @@
+/**
+ * @file student_journal.h
+ * @brief 学生数据变更日志头文件
+ * @note 声明学生增删改操作的追加式日志：每次变更只向日志末尾追加一条记录，
+ *       启动时在CSV文件或二进制快照之上重放，日志达到阈值时在退出时压缩为新的CSV文件和快照
+ *       变更由后台自动保存线程定时批量写入，交互菜单不必等待磁盘
+ */
+
+#ifndef STUDENT_JOURNAL_H
+#define STUDENT_JOURNAL_H
+
+#include <stdbool.h>
+#include "types.h"
+
+// 日志记录类型，写在每条记录的开头
+#define JOURNAL_RECORD_UPSERT 'U'        // 新增或修改：记录内容为完整的CSV数据行
+#define JOURNAL_RECORD_DELETE 'D'        // 删除：记录内容为学号
+
+/**
+ * @brief 重放变更日志
+ * @details 读取STUDENTS_JOURNAL_FILE，校验每条记录的CRC32C后依次应用到学生存储：
+ *          新增或修改按学号覆盖已有记录（不存在时追加），删除按学号移除
+ * @note 应在学生数据从CSV文件或快照加载完成后、初始化统计缓存之前调用
+ * @note 末尾不完整或校验失败的记录（如写入时断电）被丢弃，并把日志截断到最后一条完整记录
+ * @note 记录按学号覆盖或删除，同一日志重放多次的结果相同，因此CSV保存后、清空日志前中断也不会出错
+ */
+void replayStudentJournal();
+
+/**
+ * @brief 记录学生的新增或修改
+ * @details 把学生的完整数据行交给自动保存线程写入变更日志；没有自动保存线程时直接追加，需要时按批量调用fsync
+ * @param student 学生记录（必须是学生数组中的有效记录）
+ * @note 日志无法写入时输出警告并设置dataModified，退出时改为完整保存CSV文件
+ */
+void journalStudentSaved(const Student *student);
+
+/**
+ * @brief 记录学生的删除
+ * @param studentID 被删除学生的学号
+ * @note 日志无法写入时输出警告并设置dataModified，退出时改为完整保存CSV文件
+ */
+void journalStudentRemoved(const char *studentID);
+
+/**
+ * @brief 写完待写入的变更并停止自动保存线程
+ * @details 通知自动保存线程写入剩余的变更后退出，并等待它结束；之后的变更直接追加到日志
+ * @note 在退出时保存数据之前调用；后台写入失败时输出警告并设置dataModified
+ */
+void flushStudentJournal();
+
+/**
+ * @brief 把变更日志写入磁盘
+ * @details 对尚未同步的记录调用一次fsync
+ * @return 成功（或没有待同步的记录）返回true，否则返回false
+ * @note 自动保存线程运行时由该线程调用
+ */
+bool syncStudentJournal();
+
+/**
+ * @brief 判断变更日志是否需要压缩
+ * @return 日志记录数达到runtimeOptions.compactRecords时返回true
+ * @note 压缩即调用saveStudentsToFile()完整保存，保存成功后日志被清空；应在flushStudentJournal()之后调用
+ */
+bool studentJournalNeedsCompaction();
+
+/**
+ * @brief 清空变更日志
+ * @details 先写完待写入的变更，再关闭并删除STUDENTS_JOURNAL_FILE；删除之前先同步CSV文件所在的目录
+ * @note 由saveStudentsToFile()在CSV文件保存成功后调用
+ */
+void resetStudentJournal();
+
+/**
+ * @brief 关闭变更日志
+ * @details 写完待写入的变更，同步尚未写入磁盘的记录并关闭文件，在系统退出时调用
+ */
+void closeStudentJournal();
+
+#endif // STUDENT_JOURNAL_H
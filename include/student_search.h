@@ -42,7 +42,7 @@ void displayAllStudents();
 /**
  * @brief 显示单个学生详细信息
  * @details 显示指定学生的完整详细信息，包括基本信息和所有课程成绩
- * @param student 指向要显示信息的学生结构体的常量指针
+ * @param student 指向要显示信息的学生结构体的常量指针（学生数组中的记录，详细信息通过句柄获取）
  * @note 显示内容：
  *       - 基本信息：学号、姓名、年龄、性别、课程数量
  *       - 课程成绩：每门课程的名称和分数
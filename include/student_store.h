@@ -0,0 +1,166 @@
+/**
+ * @file student_store.h
+ * @brief 学生动态存储容器头文件
+ * @note 声明学生数组的扩容、预留、收缩和释放等内存管理功能，成绩列式视图的同步，
+ *       稳定学生句柄的解析，以及详细信息的延迟解码
+ */
+
+#ifndef STUDENT_STORE_H
+#define STUDENT_STORE_H
+
+#include <stdbool.h>
+#include "types.h"
+
+/**
+ * @brief 预留学生存储容量
+ * @details 将学生数组的容量调整为至少capacity个记录，已有数据保持不变
+ * @param capacity 期望的最小容量
+ * @return 如果容量已满足或扩容成功返回true，内存不足时返回false
+ * @note 容量只增不减，需要收缩请调用shrinkStudentStore()
+ */
+bool reserveStudents(int capacity);
+
+/**
+ * @brief 确保学生数组可以再容纳一条记录
+ * @details 当数组已满时按倍增策略扩容（初始容量为INITIAL_STUDENT_CAPACITY）
+ * @return 如果有空闲位置返回true，内存不足时返回false
+ * @note 倍增扩容使追加操作的均摊时间复杂度为O(1)
+ */
+bool ensureStudentCapacity();
+
+/**
+ * @brief 开始原地追加学生记录
+ * @details 确保容量后返回数组末尾的空闲位置和对应的详细信息位置，调用者可直接在其中填充数据
+ * @param detail 输出参数，指向新记录详细信息（冷数据）的空闲位置
+ * @return 指向空闲位置的指针，内存不足时返回NULL
+ * @note 填充完成后调用commitAppendStudent()使记录生效；不提交则该位置被下次追加覆盖
+ */
+Student *beginAppendStudent(StudentDetail **detail);
+
+/**
+ * @brief 提交原地追加的学生记录
+ * @details 为beginAppendStudent()返回位置上的记录计算学号编码键、分配句柄、同步列式视图并计入学生数量
+ * @return 成功返回true，句柄分配失败（内存不足）返回false
+ */
+bool commitAppendStudent();
+
+/**
+ * @brief 追加学生记录
+ * @details 将学生记录复制到学生数组末尾，必要时自动扩容，并为其分配新的句柄
+ * @param student 要追加的学生记录（其中的handle和idKey字段会被覆盖）
+ * @param detail 学生详细信息
+ * @return 指向数组中新记录的指针，内存不足时返回NULL
+ * @warning 扩容后之前获取的学生指针可能失效
+ */
+Student *appendStudent(const Student *student, const StudentDetail *detail);
+
+/**
+ * @brief 追加详细信息延迟解码的学生记录
+ * @details 与appendStudent()相同，但只用detail填充列式视图，不保存详细信息本身，
+ *          而是记录其源数据位置，首次通过getStudentDetail()访问时再由解码函数读取
+ * @param student 要追加的学生记录（其中的handle和idKey字段会被覆盖）
+ * @param detail 学生详细信息，只用于填充列式视图，调用后即可丢弃
+ * @param source 详细信息的源数据位置，传给setStudentDetailLoader()设置的解码函数
+ * @return 成功返回true，内存不足返回false
+ */
+bool appendDeferredStudent(const Student *student, const StudentDetail *detail, uint64_t source);
+
+/**
+ * @brief 删除指定位置的学生记录
+ * @details 删除index处的记录，后续记录整体前移以保持原有顺序
+ *          被删除记录的句柄失效，其他记录的句柄保持有效
+ * @param index 要删除的记录下标
+ * @note 如果下标无效，函数不做任何操作
+ */
+void removeStudentAt(int index);
+
+/**
+ * @brief 收缩学生存储容量
+ * @details 将容量收缩到当前记录数（不少于INITIAL_STUDENT_CAPACITY），释放多余内存
+ * @note 通常在批量加载完成后调用，使内存占用与实际记录数一致
+ */
+void shrinkStudentStore();
+
+/**
+ * @brief 同步单个学生的列式视图
+ * @details 将students[index]及其详细信息中统计相关的字段复制到studentColumns对应位置
+ * @param index 学生下标
+ * @note 原地修改学生记录后必须调用，否则统计结果会使用旧数据
+ */
+void syncStudentColumns(int index);
+
+/**
+ * @brief 学生数组整体重排后更新索引
+ * @details 按学生数组的当前顺序重排studentColumns，并更新槽位表中的下标
+ * @note 在整体重排（如排序）后调用；句柄随记录一起移动，因此重排后依然有效
+ * @note 列按槽位表中的原下标搬移，不访问详细信息，延迟加载的记录不会因排序而被解码
+ */
+void refreshStudentIndex();
+
+/**
+ * @brief 解析学生句柄
+ * @details 通过槽位表把句柄转换为学生数组的当前下标
+ * @param handle 学生句柄
+ * @return 学生数组下标，句柄无效或记录已删除时返回-1
+ * @note 时间复杂度O(1)
+ */
+int resolveStudentHandle(StudentHandle handle);
+
+/**
+ * @brief 获取学生详细信息
+ * @details 根据学生记录中的句柄槽位定位其详细信息（姓名、课程和成绩）
+ *          延迟加载的记录在首次访问时由解码函数从源数据中读取
+ * @param student 学生记录（必须是学生数组中的有效记录）
+ * @return 指向详细信息的指针
+ * @note 详细信息按槽位分页存放，学生排序、删除或新增后指针依然有效
+ * @warning 首次访问延迟加载的记录会修改存储，不能与其他线程并发调用
+ */
+StudentDetail *getStudentDetail(const Student *student);
+
+/**
+ * @brief 设置详细信息解码函数
+ * @param loader 解码函数，用于appendDeferredStudent()追加的记录；NULL表示取消
+ */
+void setStudentDetailLoader(StudentDetailLoader loader);
+
+/**
+ * @brief 解码全部延迟加载的详细信息
+ * @details 依次解码尚未访问过的记录，完成后不再需要源数据
+ * @return 全部解码成功（或没有延迟加载的记录）返回true，内存不足返回false
+ * @note 在源数据（如映射的CSV文件）失效之前调用，例如覆盖写入CSV文件之前
+ */
+bool materializeAllStudents();
+
+/**
+ * @brief 标记课程列尚未填充
+ * @details 按列投影加载时没有解析各科课程和成绩，列式视图中的课程编号和成绩列为0，
+ *          在ensureCourseColumns()中解码全部记录后补齐
+ * @note 课程数量列不受影响，加载时已经解析
+ */
+void markCourseColumnsPending();
+
+/**
+ * @brief 确保列式视图中的课程列已填充
+ * @details 课程列被标记为尚未填充时，解码全部记录并按详细信息重新填充列式视图
+ * @return 课程列可用返回true，内存不足返回false
+ * @note 解码会在课程字典中登记新的课程，按课程编号分配数组之前调用
+ * @see markCourseColumnsPending()
+ */
+bool ensureCourseColumns();
+
+/**
+ * @brief 通过句柄获取学生记录
+ * @param handle 学生句柄
+ * @return 指向学生记录的指针，句柄无效时返回NULL
+ * @warning 返回的指针在学生数组扩容、删除或排序后失效，需要长期引用时请保存句柄
+ */
+Student *getStudentByHandle(StudentHandle handle);
+
+/**
+ * @brief 释放学生存储
+ * @details 释放学生数组、详细信息、列式视图和槽位表占用的全部内存，并将学生数量和容量清零
+ * @note 在系统退出时调用
+ */
+void freeStudentStore();
+
+#endif // STUDENT_STORE_H
@@ -11,16 +11,43 @@
 
 // 系统初始化和清理函数
 
+/**
+ * @brief 解析命令行选项
+ * @details 识别程序启动参数并写入runtimeOptions，目前支持：
+ *          --persist    创建二进制快照STUDENTS_HEAP_FILE，之后的启动默认从快照恢复数据
+ *          --threads=N  CSV加载和保存使用N个线程（1到MAX_LOAD_THREADS），默认按CPU核数自动选择
+ *          --lazy       延迟加载，姓名和课程明细在首次访问时才从CSV文件解码
+ *          --columns=C  按列投影加载：scores跳过姓名，aggregates再跳过各科课程成绩，all解析全部字段；
+ *                       跳过的字段在首次访问时解码，因此同时启用--lazy
+ *          --compact=N  变更日志达到N条记录时，退出时完整保存CSV文件并清空日志；0表示每次退出都完整保存
+ *          --autosave=MS          后台自动保存线程每隔MS毫秒把变更写入日志；0表示不启动线程，每次变更直接写入
+ *          --autosave-changes=N   待写入的变更达到N条时立即自动保存
+ *          --sync-io    不使用io_uring，保存和流式读取改用pread/pwrite
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @note 应在initializeSystem()之前调用；无法识别的选项会输出警告并被忽略
+ */
+void parseCommandLineOptions(int argc, char *argv[]);
+
 /**
  * @brief 初始化系统
- * @details 执行系统启动时的初始化操作，包括创建必要的数据目录
- *          调用createDataDirectories函数创建数据存储目录
+ * @details 执行系统启动时的初始化操作，包括创建必要的数据目录和加载用户数据
+ *          学生数据在后台线程中加载，登录流程无需等待解析完成
  * @return 如果初始化成功返回true，否则返回false
  * @note 此函数应在程序启动时调用
  * @note 如果初始化失败，会输出错误信息
+ * @note 访问学生数据之前必须先调用waitForStudentData()；无法创建线程时（或在Windows下）同步加载
  */
 bool initializeSystem();
 
+/**
+ * @brief 等待学生数据加载完成
+ * @details 学生数据就绪的屏障：后台加载尚未完成时阻塞，并按LOAD_PROGRESS_INTERVAL_MS刷新加载进度，
+ *          完成后显示加载期间暂存的消息（加载吞吐量、格式错误等）
+ * @note 任何访问学生数据的操作之前都必须调用；已经就绪时立即返回，可以重复调用
+ */
+void waitForStudentData();
+
 /**
  * @brief 创建数据目录
  * @details 创建程序运行所需的数据存储目录
@@ -34,10 +61,25 @@ bool createDataDirectories();
 /**
  * @brief 清理系统资源
  * @details 执行程序退出前的清理操作
- *          目前主要输出清理完成的提示信息
+ *          等待后台加载线程结束（丢弃其暂存的消息），再释放学生存储、统计缓存和课程字典占用的动态内存
  * @note 此函数应在程序退出前调用
  * @note 可以根据需要添加更多清理操作，如关闭文件、释放内存等
  */
 void cleanupSystem();
 
+/**
+ * @brief 获取当前时间
+ * @details 基于C11的timespec_get()，精度为纳秒级，用于测量加载、保存等操作的耗时
+ * @return 以秒为单位的当前时间
+ * @note 只适合计算两次调用之间的时间差，不要用作日期
+ */
+double getCurrentTimeSeconds();
+
+/**
+ * @brief 获取可用的CPU核数
+ * @details Unix/Linux下使用sysconf查询在线处理器数量，Windows下使用GetSystemInfo
+ * @return CPU核数，查询失败时返回1
+ */
+int getProcessorCount();
+
 #endif // SYSTEM_UTILS_H
\ No newline at end of file
@@ -8,27 +8,115 @@
 #define TYPES_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "config.h"
 #include "security_utils.h"
 
 // 核心数据结构
 
 /**
- * @brief 学生信息结构体
- * @note 包含学生的基本信息、课程和成绩数据
+ * @brief 课程编号类型
+ * @note 课程名称统一登记在课程字典中，学生记录只保存编号
+ * @see internCourse(), getCourseName()
+ */
+typedef uint16_t CourseId;
+
+/**
+ * @brief 定点成绩类型
+ * @details 以百分之一分为单位保存成绩，例如88.50分保存为8850
+ * @note 单科成绩和平均分不超过MAX_SCORE * SCORE_SCALE，16位即可容纳
+ * @see parseScore(), formatScore(), scoreToFloat()
+ */
+typedef int16_t Score;
+
+/**
+ * @brief 定点总分类型
+ * @note 单位与Score相同，MAX_COURSES门课程的总分需要32位
+ */
+typedef int32_t ScoreTotal;
+
+/**
+ * @brief 学生句柄
+ * @details 稳定引用一条学生记录，不随删除、排序等导致的数组位置变化而失效
+ *          slot为槽位表下标，generation为槽位代数；记录删除后槽位代数递增，旧句柄随之失效
+ * @note generation为0表示无效句柄
+ * @see resolveStudentHandle()
+ */
+typedef struct {
+    uint32_t slot;                          // 槽位下标
+    uint32_t generation;                    // 槽位代数
+} StudentHandle;
+
+/**
+ * @brief 学生信息结构体（热数据）
+ * @details 只包含排序、查找、排名和统计频繁访问的字段，记录紧凑，
+ *          排序和删除时移动的字节数少
+ * @note 姓名和课程成绩保存在StudentDetail中，通过getStudentDetail()访问
+ * @see StudentDetail
  */
 typedef struct {
     char studentID[MAX_ID_LENGTH];          // 学号
-    char name[MAX_NAME_LENGTH];             // 姓名
+    uint64_t idKey;                         // 学号编码键（由学生存储在加入时计算）
     int age;                                // 年龄
     char gender;                            // 性别 ('M'/'F')
-    char courses[MAX_COURSES][MAX_COURSE_NAME_LENGTH]; // 课程名称
-    float scores[MAX_COURSES];              // 各科成绩
-    int courseCount;                        // 课程数量
-    float totalScore;                       // 总分
-    float averageScore;                     // 平均分
+    Score averageScore;                     // 平均分（定点）
+    ScoreTotal totalScore;                  // 总分（定点）
+    StudentHandle handle;                   // 稳定句柄（由学生存储分配）
 } Student;
 
+/**
+ * @brief 学生详细信息结构体（冷数据）
+ * @details 姓名和课程成绩只在显示、编辑和保存时访问
+ * @note 按句柄槽位存放，排序和删除学生时不会移动
+ * @see getStudentDetail()
+ */
+typedef struct {
+    char name[MAX_NAME_LENGTH];             // 姓名
+    int courseCount;                        // 课程数量
+    CourseId courseIds[MAX_COURSES];        // 课程编号（课程字典中的编号）
+    Score scores[MAX_COURSES];              // 各科成绩（定点）
+} StudentDetail;
+
+/**
+ * @brief 学生详细信息解码函数
+ * @details 延迟加载时，详细信息在首次访问前只保存为源数据中的位置，由该函数解码
+ * @param source 记录在源数据中的位置（如CSV文件中的行偏移）
+ * @param detail 输出参数，解码得到的详细信息
+ * @return 解码成功返回true，否则返回false
+ * @see setStudentDetailLoader(), getStudentDetail()
+ */
+typedef bool (*StudentDetailLoader)(uint64_t source, StudentDetail *detail);
+
+/**
+ * @brief 学生记录处理函数
+ * @details 流式读取CSV文件时，每解析出一条记录调用一次，记录只在调用期间有效
+ * @param student 学生记录
+ * @param detail 学生详细信息
+ * @param context 调用者提供的上下文
+ * @return 继续读取返回true，返回false时停止读取
+ * @see streamStudentsFromFile()
+ */
+typedef bool (*StudentVisitor)(const Student *student, const StudentDetail *detail, void *context);
+
+/**
+ * @brief 学生成绩列式视图
+ * @details 将统计计算需要的字段按列连续存放，与学生数组一一对应（下标相同）
+ *          统计内核顺序扫描这些数组，不必逐条跨越完整的学生记录
+ * @note 课程成绩按课程位置分列：courseScores[j][i]为第i个学生的第j门课程成绩
+ * @see syncStudentColumns(), refreshStudentIndex()
+ */
+typedef struct {
+    Score *averageScore;                    // 平均分列
+    ScoreTotal *totalScore;                 // 总分列
+    int *age;                               // 年龄列
+    char *gender;                           // 性别列
+    unsigned char *courseCount;             // 课程数量列
+    CourseId *courseIds[MAX_COURSES];       // 各课程位置的课程编号列
+    Score *courseScores[MAX_COURSES];       // 各课程位置的成绩列
+    int capacity;                           // 列数组容量（与学生数组容量一致）
+} StudentColumns;
+
 /**
  * @brief 用户信息结构体
  * @note 包含用户登录信息和权限设置
@@ -47,9 +135,9 @@ typedef struct {
  */
 typedef struct {
     int studentCount;
-    float maxScore;
-    float minScore;
-    float totalScore;
+    Score maxScore;
+    Score minScore;
+    int64_t totalScore;              // 定点成绩之和，大量学生时超出32位
     float averageScore;
     float passRate;
 } CourseStats;
@@ -71,9 +159,9 @@ typedef struct {
  * @note 用于学生排名功能
  */
 typedef struct {
-    int studentIndex;
-    float averageScore;
-    float totalScore;
+    StudentHandle handle;            // 学生句柄，排序和删除其他学生后仍然有效
+    Score averageScore;
+    ScoreTotal totalScore;
 } StudentRank;
 
 /**
@@ -85,14 +173,65 @@ typedef struct {
     int maleCount;
     int femaleCount;
     float averageAge;
-    float highestAverage;
-    float lowestAverage;
+    Score highestAverage;
+    Score lowestAverage;
     float overallAverageScore;
     float standardDeviation;
     int totalCourses;
     float averageCoursesPerStudent;
 } OverallStats;
 
+/**
+ * @brief 课程成绩累加器
+ * @note 计数使用64位整数，单门课程的记录数可以超过int范围
+ */
+typedef struct {
+    int64_t studentCount;            // 成绩条数
+    int64_t passCount;               // 及格人数
+    int64_t totalScore;              // 定点成绩之和
+    Score maxScore;
+    Score minScore;
+} CourseAccumulator;
+
+/**
+ * @brief 统计累加器结构体
+ * @details 逐条累计学生记录的中间结果，全部为整数，可以按任意顺序合并，
+ *          合并结果与一次累计全部记录完全相同，因此可分文件、分块统计后再汇总
+ * @note 标准差由平均分的和与平方和得出，不需要第二遍扫描
+ * @see accumulateStudent(), mergeStatsAccumulator()
+ */
+typedef struct {
+    int64_t studentCount;
+    int64_t maleCount;
+    int64_t femaleCount;
+    int64_t totalAge;
+    int64_t totalCourseCount;
+    int64_t totalAverage;            // 平均分（定点）之和
+    int64_t averageSquares;          // 平均分（定点）平方和
+    Score highestAverage;
+    Score lowestAverage;
+    int64_t atLeast[4];              // 平均分不低于90、80、70、60分的人数
+    CourseAccumulator *courses;      // 按课程编号索引的课程累加器
+    int courseCapacity;              // 课程累加器数组容量
+} StatsAccumulator;
+
+/**
+ * @brief 总体统计累计值
+ * @details 统计缓存中总体统计各项指标的和，学生增删改时按差值加减，不必重新扫描全部学生
+ * @note 最高和最低平均分不在此累计，取自按平均分排序的排名缓存两端
+ */
+typedef struct {
+    int maleCount;                   // 男生人数
+    int femaleCount;                 // 女生人数
+    int64_t totalAge;                // 年龄之和
+    int64_t totalCourseCount;        // 课程数量之和
+    int64_t totalAverage;            // 平均分（定点）之和
+    int64_t averageSquares;          // 平均分（定点）平方和
+    int *courseUsage;                // 按课程编号索引的选课记录数（动态分配）
+    int courseUsageCapacity;         // courseUsage数组容量
+    int coursesInUse;                // 选课记录数大于0的课程数
+} OverallSums;
+
 /**
  * @brief 统计缓存结构体
  * @note 用于缓存统计计算结果，提高性能
@@ -101,9 +240,106 @@ typedef struct {
     bool isValid;                    // 缓存是否有效
     OverallStats overallStats;       // 总体统计缓存
     ScoreDistribution scoreDistribution; // 分数分布缓存
-    StudentRank rankings[MAX_STUDENTS];   // 排名缓存
+    StudentRank *rankings;           // 排名缓存（动态分配）
+    int rankingCapacity;             // 排名缓存容量
     int lastStudentCount;            // 上次缓存时的学生数量
     unsigned long lastDataHash;     // 数据哈希值，用于检测数据变化
+    OverallSums overallSums;         // 总体统计累计值，增删改时增量更新
 } StatisticsCache;
 
+// 文件解析相关结构体
+
+/**
+ * @brief CSV字段结构体
+ * @details 指向原始数据中的一个字段，不复制内容，也不要求以'\0'结尾
+ * @note 只在所指向的数据（如映射的文件）有效期间使用
+ */
+typedef struct {
+    const char *start;               // 字段起始地址
+    size_t length;                   // 字段字节数
+} CsvField;
+
+/**
+ * @brief CSV行索引结构体
+ * @details 记录一行中所有字段分隔符（逗号）相对行首的偏移，由indexCsvLine()填充
+ * @note 分隔符数组按需扩容，可以在多行之间复用以避免重复分配
+ */
+typedef struct {
+    size_t *delimiters;              // 分隔符相对行首的偏移，按从左到右的顺序
+    int count;                       // 分隔符数量，字段数为count + 1
+    int capacity;                    // 分隔符数组容量
+    size_t length;                   // 行长度（不含换行符和行尾回车符）
+} CsvLineIndex;
+
+/**
+ * @brief CSV数据问题类别
+ * @details 加载时逐行校验的项目，错误记录按类别分别计数
+ */
+typedef enum {
+    CSV_ERROR_INVALID_UTF8,          // 不是合法的UTF-8编码，整行隔离，不加载
+    CSV_ERROR_AGE_FORMAT,            // 年龄格式错误
+    CSV_ERROR_AGE_RANGE,             // 年龄超出范围
+    CSV_ERROR_GENDER,                // 性别不是M或F
+    CSV_ERROR_COURSE_COUNT_FORMAT,   // 课程数量格式错误
+    CSV_ERROR_COURSE_COUNT_RANGE,    // 课程数量超出范围
+    CSV_ERROR_SCORE_FORMAT,          // 成绩（含总分、平均分）格式错误
+    CSV_ERROR_SCORE_RANGE,           // 成绩（含总分、平均分）超出范围
+    CSV_ERROR_TOTAL_MISMATCH,        // 总分与各科成绩之和不符
+    CSV_ERROR_AVERAGE_MISMATCH,      // 平均分与重新计算的结果不符
+    CSV_ERROR_KIND_COUNT             // 类别数量
+} CsvErrorKind;
+
+/**
+ * @brief CSV格式错误结构体
+ * @details 记录加载时发现的一个格式错误或超出范围的字段
+ */
+typedef struct {
+    int line;                        // 行号（从1开始，头部行为第1行）
+    int column;                      // 列号（CSV字段序号，从1开始）
+    CsvErrorKind kind;               // 问题类别
+    const char *message;             // 错误说明（静态字符串）
+    char text[32];                   // 出错的字段内容（过长时截断）
+} CsvParseError;
+
+/**
+ * @brief CSV格式错误记录结构体
+ * @details 保存前MAX_REPORTED_PARSE_ERRORS个错误的详细信息，并按类别统计错误总数
+ * @see initCsvErrorLog()
+ */
+typedef struct {
+    CsvParseError errors[MAX_REPORTED_PARSE_ERRORS]; // 错误详情，按行号顺序
+    int count;                       // 错误总数（可能大于保存的详情数）
+    int kindCounts[CSV_ERROR_KIND_COUNT]; // 各类别的错误数
+    int rowCount;                    // 存在问题的行数
+} CsvErrorLog;
+
+// 系统运行相关结构体
+
+/**
+ * @brief CSV加载时的列投影
+ * @details 指定加载时需要解析的字段，其余字段跳过不复制，首次访问记录时再从CSV文件解码
+ * @note 学号和统计字段（年龄、性别、课程数量、总分、平均分）始终解析
+ */
+typedef enum {
+    LOAD_COLUMNS_ALL,                // 解析全部字段
+    LOAD_COLUMNS_SCORES,             // 跳过姓名，解析各科课程和成绩
+    LOAD_COLUMNS_AGGREGATES          // 跳过姓名和各科课程成绩，只解析统计字段
+} LoadProjection;
+
+/**
+ * @brief 运行时选项结构体
+ * @note 由命令行参数设置，未指定的选项保持默认值
+ * @see parseCommandLineOptions()
+ */
+typedef struct {
+    bool persistentHeap;             // 是否使用二进制快照（--persist或快照文件已存在，延迟加载时不使用）
+    int loadThreads;                 // CSV加载和保存线程数（--threads=N），0表示按CPU核数自动选择
+    bool lazyLoad;                   // 是否延迟解码学生详细信息（--lazy）
+    LoadProjection projection;       // CSV加载时的列投影（--columns=），不为LOAD_COLUMNS_ALL时同时延迟解码
+    int compactRecords;              // 变更日志压缩阈值（--compact=N），0表示每次退出都完整保存
+    int autosaveIntervalMs;          // 自动保存间隔（--autosave=MS），0表示不启动后台线程，变更直接写入日志
+    int autosaveChanges;             // 自动保存变更数阈值（--autosave-changes=N）
+    bool syncIo;                     // 不使用io_uring，异步读写退回pread/pwrite（--sync-io）
+} RuntimeOptions;
+
 #endif // TYPES_H
\ No newline at end of file
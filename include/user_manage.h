@@ -43,6 +43,7 @@ void loadUsersFromFile();
  *          采用文本格式存储，每个用户占一行
  * @note 文件格式：每行格式为 "username:password:isAdmin"
  *       其中isAdmin为1表示管理员，0表示普通用户
+ * @note 先写入临时文件，fsync后重命名替换USERS_FILE，保存中途崩溃不会损坏原文件
  * @warning 如果文件无法打开，将显示错误信息
  */
 void saveUsersToFile();
@@ -0,0 +1,488 @@
+/**
+ * @file async_io.c
+ * @brief 异步文件读写实现
+ * @note Linux下不依赖liburing，直接用io_uring_setup/io_uring_enter系统调用创建和驱动提交队列与完成队列，
+ *       请求使用IORING_OP_READV/IORING_OP_WRITEV（Linux 5.1起支持）；
+ *       其他情况退回到pread/pwrite（Windows下为_lseeki64加_read/_write），提交时即同步完成
+ */
+
+#ifndef _WIN32
+#define _DEFAULT_SOURCE // pread/pwrite和syscall
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define ASYNC_IO_URING
+#endif
+#endif
+#endif
+
+#include "globals.h"
+#include "async_io.h"
+
+#ifdef ASYNC_IO_URING
+/**
+ * @brief io_uring实例
+ * @details 提交队列、完成队列和提交队列项数组都通过mmap与内核共享
+ */
+struct AsyncRing {
+    int fd;                                         // io_uring_setup()返回的描述符
+    void *queueMemory;                              // 提交队列（和完成队列）的映射
+    size_t queueSize;
+    void *completeMemory;                           // 完成队列的映射，与提交队列共用一次映射时等于queueMemory
+    size_t completeSize;
+    struct io_uring_sqe *entries;                   // 提交队列项数组的映射
+    size_t entriesSize;
+    uint32_t *submitTail;                           // 提交队列尾，由本进程推进
+    uint32_t submitMask;
+    uint32_t *submitArray;                          // 提交队列中各位置对应的队列项下标
+    uint32_t *completeHead;                         // 完成队列头，由本进程推进
+    uint32_t *completeTail;                         // 完成队列尾，由内核推进
+    uint32_t completeMask;
+    struct io_uring_cqe *completions;               // 完成队列项
+    struct iovec vectors[ASYNC_IO_SLOTS][ASYNC_IO_MAX_BUFFERS]; // 各请求槽的缓冲区描述，请求完成前内核会读取
+};
+#endif
+
+/**
+ * @brief 同步完成读写
+ * @details 从请求的第skip个字节开始，用pread/pwrite完成剩余部分
+ * @param fd 文件描述符
+ * @param request 读写请求
+ * @param skip 已完成的字节数
+ * @return 包括skip在内完成的字节数，出错返回负的错误码
+ * @note 读取到文件末尾时提前返回
+ */
+static int64_t transferSync(int fd, const AsyncRequest *request, size_t skip)
+{
+    size_t done = skip;
+    uint64_t offset = request->offset + skip;
+    for (int i = 0; i < request->count; i++)
+    {
+        if (skip >= request->lengths[i])
+        {
+            skip -= request->lengths[i];
+            continue;
+        }
+
+        char *data = request->buffers[i] + skip;
+        size_t left = request->lengths[i] - skip;
+        skip = 0;
+        while (left > 0)
+        {
+#ifdef _WIN32
+            unsigned int chunk = left > INT32_MAX ? INT32_MAX : (unsigned int)left;
+            int moved = -1;
+            if (_lseeki64(fd, (__int64)offset, SEEK_SET) >= 0)
+                moved = request->write ? _write(fd, data, chunk) : _read(fd, data, chunk);
+#else
+            ssize_t moved = request->write ? pwrite(fd, data, left, (off_t)offset) : pread(fd, data, left, (off_t)offset);
+            if (moved < 0 && errno == EINTR)
+                continue;
+#endif
+            if (moved < 0)
+                return -(int64_t)errno;
+            if (moved == 0)
+                return request->write ? -(int64_t)EIO : (int64_t)done;
+
+            data += moved;
+            left -= (size_t)moved;
+            offset += (uint64_t)moved;
+            done += (size_t)moved;
+        }
+    }
+    return (int64_t)done;
+}
+
+/**
+ * @brief 计算请求的总字节数
+ * @param request 读写请求
+ * @return 各缓冲区字节数之和
+ */
+static size_t requestSize(const AsyncRequest *request)
+{
+    size_t size = 0;
+    for (int i = 0; i < request->count; i++)
+    {
+        size += request->lengths[i];
+    }
+    return size;
+}
+
+#ifdef ASYNC_IO_URING
+/**
+ * @brief 释放io_uring实例
+ * @param ring io_uring实例，可以只初始化了一部分
+ */
+static void freeAsyncRing(AsyncRing *ring)
+{
+    if (ring->entries != NULL)
+        munmap(ring->entries, ring->entriesSize);
+    if (ring->completeMemory != NULL && ring->completeMemory != ring->queueMemory)
+        munmap(ring->completeMemory, ring->completeSize);
+    if (ring->queueMemory != NULL)
+        munmap(ring->queueMemory, ring->queueSize);
+    if (ring->fd >= 0)
+        close(ring->fd);
+    free(ring);
+}
+
+/**
+ * @brief 映射io_uring共享内存
+ * @param fd io_uring描述符
+ * @param size 映射字节数
+ * @param offset IORING_OFF_SQ_RING、IORING_OFF_CQ_RING或IORING_OFF_SQES
+ * @return 映射地址，失败返回NULL
+ */
+static void *mapRingMemory(int fd, size_t size, uint64_t offset)
+{
+    void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, (off_t)offset);
+    return memory == MAP_FAILED ? NULL : memory;
+}
+
+/**
+ * @brief 创建io_uring实例
+ * @return io_uring实例，内核不支持、被禁用或内存不足时返回NULL
+ */
+static AsyncRing *createAsyncRing()
+{
+    AsyncRing *ring = calloc(1, sizeof(AsyncRing));
+    if (ring == NULL)
+        return NULL;
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring->fd = (int)syscall(__NR_io_uring_setup, ASYNC_IO_SLOTS, &params);
+    if (ring->fd < 0)
+    {
+        free(ring);
+        return NULL;
+    }
+
+    ring->queueSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    ring->completeSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        // 提交队列和完成队列共用一次映射
+        if (ring->completeSize > ring->queueSize)
+            ring->queueSize = ring->completeSize;
+        ring->completeSize = ring->queueSize;
+    }
+
+    ring->queueMemory = mapRingMemory(ring->fd, ring->queueSize, IORING_OFF_SQ_RING);
+    if (ring->queueMemory != NULL)
+    {
+        ring->completeMemory = (params.features & IORING_FEAT_SINGLE_MMAP)
+                                   ? ring->queueMemory
+                                   : mapRingMemory(ring->fd, ring->completeSize, IORING_OFF_CQ_RING);
+    }
+    ring->entriesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->entries = mapRingMemory(ring->fd, ring->entriesSize, IORING_OFF_SQES);
+    if (ring->queueMemory == NULL || ring->completeMemory == NULL || ring->entries == NULL)
+    {
+        freeAsyncRing(ring);
+        return NULL;
+    }
+
+    char *queue = ring->queueMemory;
+    ring->submitTail = (uint32_t *)(queue + params.sq_off.tail);
+    ring->submitMask = *(uint32_t *)(queue + params.sq_off.ring_mask);
+    ring->submitArray = (uint32_t *)(queue + params.sq_off.array);
+
+    char *complete = ring->completeMemory;
+    ring->completeHead = (uint32_t *)(complete + params.cq_off.head);
+    ring->completeTail = (uint32_t *)(complete + params.cq_off.tail);
+    ring->completeMask = *(uint32_t *)(complete + params.cq_off.ring_mask);
+    ring->completions = (struct io_uring_cqe *)(complete + params.cq_off.cqes);
+    return ring;
+}
+
+/**
+ * @brief 把请求放入提交队列并通知内核
+ * @param async 异步读写状态
+ * @param slot 请求槽
+ * @return 内核接受了请求返回true；失败时队列项已撤回，由调用者改为同步完成
+ * @note 同时进行的请求不超过ASYNC_IO_SLOTS个，提交队列不会满
+ */
+static bool submitRingRequest(AsyncFile *async, int slot)
+{
+    AsyncRing *ring = async->ring;
+    AsyncRequest *request = &async->requests[slot];
+    for (int i = 0; i < request->count; i++)
+    {
+        ring->vectors[slot][i].iov_base = request->buffers[i];
+        ring->vectors[slot][i].iov_len = request->lengths[i];
+    }
+
+    // 提交队列尾只由本进程修改，内核读取前需要看到已填好的队列项
+    uint32_t tail = *ring->submitTail;
+    uint32_t index = tail & ring->submitMask;
+    struct io_uring_sqe *entry = &ring->entries[index];
+    memset(entry, 0, sizeof(*entry));
+    entry->opcode = request->write ? IORING_OP_WRITEV : IORING_OP_READV;
+    entry->fd = async->fd;
+    entry->off = request->offset;
+    entry->addr = (uint64_t)(uintptr_t)ring->vectors[slot];
+    entry->len = (uint32_t)request->count;
+    entry->user_data = (uint64_t)slot;
+    ring->submitArray[index] = index;
+    atomic_store_explicit((_Atomic uint32_t *)ring->submitTail, tail + 1, memory_order_release);
+
+    long submitted;
+    do
+    {
+        submitted = syscall(__NR_io_uring_enter, ring->fd, 1, 0, 0, NULL, 0);
+    } while (submitted < 0 && errno == EINTR);
+    if (submitted == 1)
+        return true;
+
+    // 内核没有取走队列项（如EAGAIN、ENOMEM），撤回队列尾，否则之后等待时它永远不会被提交
+    atomic_store_explicit((_Atomic uint32_t *)ring->submitTail, tail, memory_order_release);
+    return false;
+}
+
+/**
+ * @brief 取回完成队列中的全部结果
+ * @param async 异步读写状态
+ */
+static void reapRingCompletions(AsyncFile *async)
+{
+    AsyncRing *ring = async->ring;
+    uint32_t head = *ring->completeHead;
+    uint32_t tail = atomic_load_explicit((_Atomic uint32_t *)ring->completeTail, memory_order_acquire);
+    while (head != tail)
+    {
+        const struct io_uring_cqe *completion = &ring->completions[head & ring->completeMask];
+        if (completion->user_data < ASYNC_IO_SLOTS)
+        {
+            AsyncRequest *request = &async->requests[completion->user_data];
+            request->result = completion->res;
+            request->completed = true;
+        }
+        head++;
+    }
+    atomic_store_explicit((_Atomic uint32_t *)ring->completeHead, head, memory_order_release);
+}
+
+/**
+ * @brief 放弃io_uring实例
+ * @details 关闭io_uring描述符，由内核取消仍在进行的请求；尚未完成的请求按出错处理，之后改用pread/pwrite
+ * @param async 异步读写状态
+ */
+static void abandonAsyncRing(AsyncFile *async)
+{
+    freeAsyncRing(async->ring);
+    async->ring = NULL;
+    for (int slot = 0; slot < ASYNC_IO_SLOTS; slot++)
+    {
+        AsyncRequest *request = &async->requests[slot];
+        if (request->pending && !request->completed)
+        {
+            request->result = -(int64_t)EIO;
+            request->completed = true;
+        }
+    }
+}
+
+/**
+ * @brief 等待请求在io_uring中完成
+ * @param async 异步读写状态
+ * @param slot 请求槽
+ * @return 请求已完成返回true，等待出错返回false
+ */
+static bool waitRingRequest(AsyncFile *async, int slot)
+{
+    AsyncRequest *request = &async->requests[slot];
+    reapRingCompletions(async);
+    while (!request->completed)
+    {
+        long waited = syscall(__NR_io_uring_enter, async->ring->fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+        if (waited < 0 && errno != EINTR)
+            return false;
+        reapRingCompletions(async);
+    }
+    return true;
+}
+#endif
+
+/**
+ * @brief 准备异步读写
+ * @details 创建一个io_uring实例，失败或runtimeOptions.syncIo为true时改用pread/pwrite
+ * @param async 输出参数，异步读写状态
+ * @param file 已打开的文件，之后只能通过异步接口读写，不能再用stdio读写
+ * @note 读写都按显式偏移进行，不使用也不改变文件的当前位置
+ */
+void openAsyncFile(AsyncFile *async, FILE *file)
+{
+    memset(async, 0, sizeof(*async));
+#ifdef _WIN32
+    async->fd = _fileno(file);
+#else
+    async->fd = fileno(file);
+#endif
+
+#ifdef ASYNC_IO_URING
+    if (!runtimeOptions.syncIo)
+        async->ring = createAsyncRing();
+#endif
+}
+
+/**
+ * @brief 登记并提交请求
+ * @param async 异步读写状态
+ * @param slot 请求槽
+ * @return 提交成功返回true
+ * @note 没有io_uring或io_uring提交失败时立即同步完成
+ */
+static bool submitAsyncRequest(AsyncFile *async, int slot)
+{
+    AsyncRequest *request = &async->requests[slot];
+    request->pending = true;
+    request->completed = false;
+
+#ifdef ASYNC_IO_URING
+    if (async->ring != NULL && submitRingRequest(async, slot))
+        return true;
+#endif
+
+    request->result = transferSync(async->fd, request, 0);
+    request->completed = true;
+    return true;
+}
+
+/**
+ * @brief 提交读取请求
+ * @param async 异步读写状态
+ * @param slot 请求槽（0到ASYNC_IO_SLOTS - 1），槽中之前的请求必须已取回结果
+ * @param buffer 读取缓冲区
+ * @param size 最多读取的字节数
+ * @param offset 文件偏移
+ * @return 提交成功返回true
+ */
+bool submitAsyncRead(AsyncFile *async, int slot, char *buffer, size_t size, uint64_t offset)
+{
+    AsyncRequest *request = &async->requests[slot];
+    if (request->pending)
+        return false;
+
+    request->write = false;
+    request->count = 1;
+    request->buffers[0] = buffer;
+    request->lengths[0] = size;
+    request->offset = offset;
+    return submitAsyncRequest(async, slot);
+}
+
+/**
+ * @brief 提交写入请求
+ * @details 把各缓冲区的内容依次写到从offset开始的位置
+ * @param async 异步读写状态
+ * @param slot 请求槽（0到ASYNC_IO_SLOTS - 1），槽中之前的请求必须已取回结果
+ * @param buffers 缓冲区数组
+ * @param lengths 各缓冲区的字节数
+ * @param count 缓冲区数量（1到ASYNC_IO_MAX_BUFFERS）
+ * @param offset 文件偏移
+ * @return 提交成功返回true
+ */
+bool submitAsyncWrite(AsyncFile *async, int slot, char *const buffers[], const size_t lengths[], int count,
+                      uint64_t offset)
+{
+    AsyncRequest *request = &async->requests[slot];
+    if (request->pending || count < 1 || count > ASYNC_IO_MAX_BUFFERS)
+        return false;
+
+    request->write = true;
+    request->count = count;
+    for (int i = 0; i < count; i++)
+    {
+        request->buffers[i] = buffers[i];
+        request->lengths[i] = lengths[i];
+    }
+    request->offset = offset;
+    return submitAsyncRequest(async, slot);
+}
+
+/**
+ * @brief 等待请求完成
+ * @param async 异步读写状态
+ * @param slot 请求槽
+ * @return 读取或写入的字节数，出错返回-1；槽中没有请求时返回0
+ * @note 写入只完成一部分时剩余部分同步写完，因此成功时总是返回全部字节数；
+ *       读取返回的字节数小于请求的大小表示已到文件末尾
+ */
+int64_t waitAsyncRequest(AsyncFile *async, int slot)
+{
+    AsyncRequest *request = &async->requests[slot];
+    if (!request->pending)
+        return 0;
+
+#ifdef ASYNC_IO_URING
+    if (async->ring != NULL && !waitRingRequest(async, slot))
+    {
+        // 请求可能仍在进行，放弃io_uring实例，关闭时由内核取消，之后才能释放缓冲区
+        abandonAsyncRing(async);
+        request->pending = false;
+        return -1;
+    }
+#endif
+    request->pending = false;
+
+    int64_t result = request->result;
+    if (result < 0)
+        return -1;
+
+    // io_uring可能只完成一部分（如被信号打断），剩余部分同步完成
+    size_t size = requestSize(request);
+    if ((size_t)result < size && (request->write || result > 0))
+        result = transferSync(async->fd, request, (size_t)result);
+    if (result < 0 || (request->write && (size_t)result != size))
+        return -1;
+    return result;
+}
+
+/**
+ * @brief 结束异步读写
+ * @details 等待尚未完成的请求，释放io_uring实例；不关闭文件
+ * @param async 异步读写状态
+ */
+void closeAsyncFile(AsyncFile *async)
+{
+    for (int slot = 0; slot < ASYNC_IO_SLOTS; slot++)
+    {
+        waitAsyncRequest(async, slot);
+    }
+
+#ifdef ASYNC_IO_URING
+    if (async->ring != NULL)
+    {
+        freeAsyncRing(async->ring);
+        async->ring = NULL;
+    }
+#endif
+}
+
+/**
+ * @brief 获取异步读写使用的后端名称
+ * @param async 异步读写状态
+ * @return "io_uring"或"pread/pwrite"
+ */
+const char *getAsyncFileBackend(const AsyncFile *async)
+{
+    return async->ring != NULL ? "io_uring" : "pread/pwrite";
+}
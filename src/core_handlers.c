@@ -18,6 +18,7 @@
 #include "student_search.h"
 #include "student_sort.h"
 #include "statistical_analysis.h"
+#include "stream_analysis.h"
 #include "io_utils.h"
 
 /**
@@ -86,6 +87,7 @@ void handleBasicFunctions()
  *       - 成绩分布统计
  *       - 学生排名统计
  *       - 综合统计分析
+ *       - 外部文件流式统计
  */
 void handleStatistics()
 {
@@ -94,7 +96,7 @@ void handleStatistics()
     {
         clearScreen();
         displayStatisticsMenu();
-        choice = safeInputInt("请选择功能", STATS_BACK, STATS_OVERALL_ANALYSIS);
+        choice = safeInputInt("请选择功能", STATS_BACK, STATS_STREAM_ANALYSIS);
 
         switch (choice)
         {
@@ -110,6 +112,9 @@ void handleStatistics()
         case STATS_OVERALL_ANALYSIS:
             displayOverallStatistics();
             break;
+        case STATS_STREAM_ANALYSIS:
+            displayStreamingStatistics();
+            break;
         case STATS_BACK:
             break;
         default:
@@ -0,0 +1,185 @@
+/**
+ * @file course_dict.c
+ * @brief 课程名称字典实现
+ * @note 使用开放寻址哈希表将课程名称映射为连续的小整数编号
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "course_dict.h"
+#include "config.h"
+
+// 课程名称表，下标即课程编号
+static char (*courseNames)[MAX_COURSE_NAME_LENGTH] = NULL;
+static int courseNameCount = 0;
+static int courseNameCapacity = 0;
+
+// 哈希表初始槽数，必须为2的幂（线性探测使用掩码取模）
+#define INITIAL_HASH_SLOTS 64
+
+// 哈希槽保存课程编号，-1表示空槽；槽数始终为2的幂
+static int *hashSlots = NULL;
+static int hashSlotCount = 0;
+
+/**
+ * @brief 计算课程名称的哈希值
+ * @details 使用FNV-1a算法，对短字符串分布均匀且计算简单
+ * @param name 课程名称
+ * @return 32位哈希值
+ */
+static uint32_t hashCourseName(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)name; *p != '\0'; p++)
+    {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief 在哈希表中定位课程名称
+ * @param name 课程名称
+ * @return 名称所在的槽位或应插入的空槽位
+ */
+static int findSlot(const char *name)
+{
+    int mask = hashSlotCount - 1;
+    int slot = (int)(hashCourseName(name) & (uint32_t)mask);
+
+    while (hashSlots[slot] != -1 && strcmp(courseNames[hashSlots[slot]], name) != 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * @brief 重建哈希表
+ * @details 按新的槽数重新插入所有课程编号，保持装载因子不超过1/2
+ * @param newSlotCount 新槽数（2的幂）
+ * @return 成功返回true，内存不足返回false
+ */
+static bool rehash(int newSlotCount)
+{
+    int *newSlots = malloc((size_t)newSlotCount * sizeof(int));
+    if (newSlots == NULL)
+        return false;
+
+    memset(newSlots, -1, (size_t)newSlotCount * sizeof(int));
+    free(hashSlots);
+    hashSlots = newSlots;
+    hashSlotCount = newSlotCount;
+
+    for (int id = 0; id < courseNameCount; id++)
+    {
+        hashSlots[findSlot(courseNames[id])] = id;
+    }
+    return true;
+}
+
+/**
+ * @brief 登记课程名称
+ * @details 查找课程名称对应的编号，如果字典中不存在则分配新的编号
+ *          编号从0开始连续分配，同一名称始终对应同一编号
+ * @param courseName 课程名称
+ * @return 课程编号，内存不足或字典已满时返回-1
+ * @note 基于开放寻址哈希表，平均时间复杂度O(1)
+ */
+int internCourse(const char *courseName)
+{
+    if (courseName == NULL)
+        return -1;
+
+    if (hashSlots == NULL && !rehash(INITIAL_HASH_SLOTS))
+        return -1;
+
+    int slot = findSlot(courseName);
+    if (hashSlots[slot] != -1)
+        return hashSlots[slot];
+
+    if (courseNameCount >= MAX_COURSE_DICT_SIZE)
+        return -1;
+
+    if (courseNameCount == courseNameCapacity)
+    {
+        int newCapacity = courseNameCapacity == 0 ? MAX_COURSES * 2 : courseNameCapacity * 2;
+        char (*grown)[MAX_COURSE_NAME_LENGTH] =
+            realloc(courseNames, (size_t)newCapacity * MAX_COURSE_NAME_LENGTH);
+        if (grown == NULL)
+            return -1;
+        courseNames = grown;
+        courseNameCapacity = newCapacity;
+    }
+
+    int id = courseNameCount;
+    strncpy(courseNames[id], courseName, MAX_COURSE_NAME_LENGTH - 1);
+    courseNames[id][MAX_COURSE_NAME_LENGTH - 1] = '\0';
+    courseNameCount++;
+    hashSlots[slot] = id;
+
+    // 装载因子超过1/2时扩容，扩容失败不影响已登记的编号
+    if (courseNameCount * 2 > hashSlotCount)
+    {
+        rehash(hashSlotCount * 2);
+    }
+
+    return id;
+}
+
+/**
+ * @brief 查找课程编号
+ * @details 在字典中查找课程名称对应的编号，不会分配新编号
+ * @param courseName 课程名称
+ * @return 课程编号，未找到时返回-1
+ */
+int findCourseId(const char *courseName)
+{
+    if (courseName == NULL || hashSlots == NULL)
+        return -1;
+
+    return hashSlots[findSlot(courseName)];
+}
+
+/**
+ * @brief 获取课程名称
+ * @details 根据课程编号返回课程名称
+ * @param courseId 课程编号
+ * @return 课程名称，编号无效时返回空字符串
+ * @note 返回的指针在字典扩容后可能失效，不要长期保存
+ */
+const char *getCourseName(int courseId)
+{
+    if (courseId < 0 || courseId >= courseNameCount)
+        return "";
+
+    return courseNames[courseId];
+}
+
+/**
+ * @brief 获取字典中的课程数量
+ * @return 已登记的课程数量，即有效编号的上界（不包含）
+ * @note 已登记但当前没有学生选修的课程也计算在内
+ */
+int getCourseDictSize()
+{
+    return courseNameCount;
+}
+
+/**
+ * @brief 释放课程字典
+ * @details 释放字典占用的全部内存，之后的编号全部失效
+ * @note 在系统退出时调用
+ */
+void freeCourseDict()
+{
+    free(courseNames);
+    free(hashSlots);
+    courseNames = NULL;
+    hashSlots = NULL;
+    courseNameCount = 0;
+    courseNameCapacity = 0;
+    hashSlotCount = 0;
+}
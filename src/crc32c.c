@@ -0,0 +1,189 @@
+/**
+ * @file crc32c.c
+ * @brief CRC32C校验和实现
+ * @note x86下支持SSE4.2时使用crc32指令每次处理8个字节，
+ *       其他情况使用slicing-by-8查表法，每次查8张表处理8个字节
+ */
+
+#include <string.h>
+#include "crc32c.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRC32C_X86
+#include <immintrin.h>
+#endif
+
+// CRC32C多项式0x1EDC6F41的位反转形式
+#define CRC32C_POLYNOMIAL 0x82F63B78u
+
+/**
+ * @brief CRC32C计算内核
+ * @details 输入和输出都是取反之前的内部状态
+ */
+typedef uint32_t (*Crc32cKernel)(uint32_t crc, const unsigned char *data, size_t size);
+
+static uint32_t crc32cBitwise(uint32_t crc, const unsigned char *data, size_t size);
+
+// slicing-by-8查找表，crc32cTable[k][n]为字节n之后再跟k个0字节的校验和
+static uint32_t crc32cTable[8][256];
+
+// 当前使用的内核，由initCrc32c()选择
+static Crc32cKernel activeCrc32cKernel = crc32cBitwise;
+static const char *activeCrc32cName = "逐位";
+
+/**
+ * @brief 逐位计算的内核
+ * @details 不需要查找表，只在initCrc32c()之前使用
+ */
+static uint32_t crc32cBitwise(uint32_t crc, const unsigned char *data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (CRC32C_POLYNOMIAL & (0u - (crc & 1u)));
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief 按小端序读取32位整数
+ * @param data 数据地址（不要求对齐）
+ * @return 读取的整数
+ */
+static inline uint32_t loadLittleEndian32(const unsigned char *data)
+{
+    return (uint32_t)data[0] | (uint32_t)data[1] << 8 | (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24;
+}
+
+/**
+ * @brief slicing-by-8内核
+ * @details 每次读取8个字节，分别查8张表后异或，尾部不足8字节的部分逐字节查表
+ */
+static uint32_t crc32cSlicing8(uint32_t crc, const unsigned char *data, size_t size)
+{
+    while (size >= 8)
+    {
+        uint32_t low = crc ^ loadLittleEndian32(data);
+        uint32_t high = loadLittleEndian32(data + 4);
+        crc = crc32cTable[7][low & 0xFF] ^ crc32cTable[6][(low >> 8) & 0xFF] ^
+              crc32cTable[5][(low >> 16) & 0xFF] ^ crc32cTable[4][low >> 24] ^
+              crc32cTable[3][high & 0xFF] ^ crc32cTable[2][(high >> 8) & 0xFF] ^
+              crc32cTable[1][(high >> 16) & 0xFF] ^ crc32cTable[0][high >> 24];
+        data += 8;
+        size -= 8;
+    }
+
+    while (size > 0)
+    {
+        crc = (crc >> 8) ^ crc32cTable[0][(crc ^ *data) & 0xFF];
+        data++;
+        size--;
+    }
+    return crc;
+}
+
+#ifdef CRC32C_X86
+/**
+ * @brief SSE4.2内核
+ * @details 64位下每条crc32指令处理8个字节，32位下处理4个字节
+ */
+__attribute__((target("sse4.2")))
+static uint32_t crc32cSse42(uint32_t crc, const unsigned char *data, size_t size)
+{
+#ifdef __x86_64__
+    uint64_t crc64 = crc;
+    while (size >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        size -= 8;
+    }
+    crc = (uint32_t)crc64;
+#endif
+
+    while (size >= 4)
+    {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+        data += 4;
+        size -= 4;
+    }
+    while (size > 0)
+    {
+        crc = _mm_crc32_u8(crc, *data);
+        data++;
+        size--;
+    }
+    return crc;
+}
+#endif
+
+/**
+ * @brief 生成slicing-by-8查找表
+ */
+static void buildCrc32cTable()
+{
+    for (uint32_t n = 0; n < 256; n++)
+    {
+        unsigned char byte = (unsigned char)n;
+        crc32cTable[0][n] = crc32cBitwise(0, &byte, 1);
+    }
+    for (int k = 1; k < 8; k++)
+    {
+        for (int n = 0; n < 256; n++)
+        {
+            uint32_t previous = crc32cTable[k - 1][n];
+            crc32cTable[k][n] = (previous >> 8) ^ crc32cTable[0][previous & 0xFF];
+        }
+    }
+}
+
+/**
+ * @brief 选择CRC32C计算内核
+ * @details 运行时检测CPU指令集，支持SSE4.2时使用crc32指令，否则使用查表的slicing-by-8实现
+ * @note 多线程计算前应在主线程调用一次；未调用时使用逐位计算的实现，结果相同但速度很慢
+ */
+void initCrc32c()
+{
+#ifdef CRC32C_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        activeCrc32cKernel = crc32cSse42;
+        activeCrc32cName = "SSE4.2";
+        return;
+    }
+#endif
+
+    buildCrc32cTable();
+    activeCrc32cKernel = crc32cSlicing8;
+    activeCrc32cName = "slicing-by-8";
+}
+
+/**
+ * @brief 获取当前CRC32C内核的名称
+ * @return "SSE4.2"、"slicing-by-8"或"逐位"
+ */
+const char *getCrc32cName()
+{
+    return activeCrc32cName;
+}
+
+/**
+ * @brief 计算CRC32C校验和
+ * @details 可以分段计算：把上一段的结果作为crc传入，结果与整段一次计算相同
+ * @param crc 之前各段的校验和，第一段传0
+ * @param data 数据起始地址
+ * @param size 数据字节数
+ * @return 包括本段在内的校验和
+ */
+uint32_t crc32c(uint32_t crc, const void *data, size_t size)
+{
+    return ~activeCrc32cKernel(~crc, data, size);
+}
@@ -0,0 +1,659 @@
+/**
+ * @file csv_scan.c
+ * @brief CSV结构字符扫描器实现
+ * @note 每次比较一整块字节得到逗号、换行符和引号的位掩码，再按位提取分隔符位置
+ *       x86下运行时在AVX2（32字节）和SSE2（16字节）之间选择，其他平台使用SWAR（8字节）
+ *       同时提供UTF-8编码校验，AVX2下用查表法一次检查32个字节，否则逐字符检查并按8字节跳过ASCII
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "csv_scan.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CSV_SCAN_X86
+#include <immintrin.h>
+#endif
+
+// 行索引的初始分隔符容量，足以容纳一条完整的学生记录
+#define INITIAL_DELIMITER_CAPACITY 32
+
+/**
+ * @brief 行扫描内核
+ * @details 从line开始扫描到换行符或数据末尾，把分隔符偏移追加到index
+ * @return 换行符位置（没有换行符时为end），内存不足返回NULL
+ */
+typedef const char *(*CsvLineKernel)(const char *line, const char *end, CsvLineIndex *index);
+
+static const char *scanLineSwar(const char *line, const char *end, CsvLineIndex *index);
+
+/**
+ * @brief UTF-8校验内核
+ * @return 数据是合法的UTF-8编码返回true
+ */
+typedef bool (*Utf8Kernel)(const char *data, size_t length);
+
+static bool validateUtf8Scalar(const char *data, size_t length);
+
+// 当前使用的扫描内核，由initCsvScanner()选择
+static CsvLineKernel activeKernel = scanLineSwar;
+static Utf8Kernel activeUtf8Kernel = validateUtf8Scalar;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+static const char *activeKernelName = "标量";
+#else
+static const char *activeKernelName = "SWAR";
+#endif
+
+/**
+ * @brief 统计末尾0位的个数
+ * @param mask 非零掩码
+ * @return 最低的置位位置
+ */
+static inline int countTrailingZeros(uint32_t mask)
+{
+#ifdef __GNUC__
+    return __builtin_ctz(mask);
+#else
+    int count = 0;
+    while ((mask & 1u) == 0)
+    {
+        mask >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief 统计置位位数的奇偶
+ * @param mask 掩码
+ * @return 置位位数为奇数返回true
+ */
+static inline bool hasOddParity(uint32_t mask)
+{
+#ifdef __GNUC__
+    return (__builtin_popcount(mask) & 1) != 0;
+#else
+    mask ^= mask >> 16;
+    mask ^= mask >> 8;
+    mask ^= mask >> 4;
+    mask ^= mask >> 2;
+    mask ^= mask >> 1;
+    return (mask & 1u) != 0;
+#endif
+}
+
+/**
+ * @brief 计算前缀异或
+ * @details 结果的第i位是mask第0到第i位的异或，用于把引号位置转换为"位于引号内"的区间掩码
+ * @param mask 引号位置掩码
+ * @return 区间掩码（从开引号到闭引号之前置位）
+ */
+static inline uint32_t prefixXor(uint32_t mask)
+{
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    return mask;
+}
+
+/**
+ * @brief 追加一个分隔符偏移
+ * @param index 行索引
+ * @param offset 分隔符相对行首的偏移
+ * @return 成功返回true，内存不足返回false
+ */
+static bool appendDelimiter(CsvLineIndex *index, size_t offset)
+{
+    if (index->count == index->capacity)
+    {
+        int capacity = index->capacity == 0 ? INITIAL_DELIMITER_CAPACITY : index->capacity * 2;
+        size_t *grown = realloc(index->delimiters, (size_t)capacity * sizeof(size_t));
+        if (grown == NULL)
+            return false;
+        index->delimiters = grown;
+        index->capacity = capacity;
+    }
+
+    index->delimiters[index->count++] = offset;
+    return true;
+}
+
+/**
+ * @brief 处理一个数据块的结构字符掩码
+ * @details 截掉换行符之后的位，去掉引号内的逗号，把剩余逗号的位置追加到行索引
+ * @param index 行索引
+ * @param base 数据块相对行首的偏移
+ * @param commas 逗号掩码
+ * @param newlines 换行符掩码
+ * @param quotes 引号掩码
+ * @param inQuotes 数据块开始时是否位于引号内，返回时更新为数据块结束时的状态
+ * @return 找到换行符返回1，需要继续扫描返回0，内存不足返回-1
+ */
+static int processBlockMasks(CsvLineIndex *index, size_t base, uint32_t commas, uint32_t newlines,
+                             uint32_t quotes, bool *inQuotes)
+{
+    if (newlines != 0)
+    {
+        uint32_t beforeNewline = (1u << countTrailingZeros(newlines)) - 1;
+        commas &= beforeNewline;
+        quotes &= beforeNewline;
+    }
+
+    if (quotes != 0 || *inQuotes)
+    {
+        uint32_t inside = prefixXor(quotes);
+        if (*inQuotes)
+            inside = ~inside;
+        commas &= ~inside;
+        if (hasOddParity(quotes))
+            *inQuotes = !*inQuotes;
+    }
+
+    while (commas != 0)
+    {
+        if (!appendDelimiter(index, base + (size_t)countTrailingZeros(commas)))
+            return -1;
+        commas &= commas - 1;
+    }
+
+    return newlines != 0 ? 1 : 0;
+}
+
+/**
+ * @brief 逐字节扫描
+ * @details 用于处理向量内核剩下的不足一块的尾部，以及不支持向量化的平台
+ * @param p 扫描起始位置
+ * @param end 数据结束位置
+ * @param line 行起始位置
+ * @param index 行索引
+ * @param inQuotes 是否位于引号内
+ * @return 换行符位置（没有换行符时为end），内存不足返回NULL
+ */
+static const char *scanLineScalarFrom(const char *p, const char *end, const char *line,
+                                      CsvLineIndex *index, bool *inQuotes)
+{
+    for (; p < end; p++)
+    {
+        if (*p == '\n')
+            return p;
+
+        if (*p == '"')
+        {
+            *inQuotes = !*inQuotes;
+        }
+        else if (*p == ',' && !*inQuotes && !appendDelimiter(index, (size_t)(p - line)))
+        {
+            return NULL;
+        }
+    }
+    return end;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+/**
+ * @brief SWAR扫描内核（大端平台退化为逐字节扫描）
+ */
+static const char *scanLineSwar(const char *line, const char *end, CsvLineIndex *index)
+{
+    bool inQuotes = false;
+    return scanLineScalarFrom(line, end, line, index, &inQuotes);
+}
+#else
+/**
+ * @brief 在64位字中查找指定字节
+ * @param word 8个字节组成的字
+ * @param pattern 目标字节重复8次组成的字
+ * @return 每个字节对应一位的掩码（第i个字节匹配时第i位置位）
+ * @note 逐字节精确判断，不会因借位产生误报
+ */
+static inline uint32_t matchBytes(uint64_t word, uint64_t pattern)
+{
+    const uint64_t low7 = 0x7F7F7F7F7F7F7F7Full;
+    uint64_t x = word ^ pattern;
+    uint64_t zero = ~(((x & low7) + low7) | x | low7);
+
+    // 把每个字节的最高位收集到结果的低8位
+    return (uint32_t)(((zero >> 7) * 0x0102040810204080ull) >> 56);
+}
+
+/**
+ * @brief SWAR扫描内核
+ * @details 用普通64位整数运算一次比较8个字节，适用于所有小端平台
+ */
+static const char *scanLineSwar(const char *line, const char *end, CsvLineIndex *index)
+{
+    const uint64_t commaPattern = 0x2C2C2C2C2C2C2C2Cull;
+    const uint64_t newlinePattern = 0x0A0A0A0A0A0A0A0Aull;
+    const uint64_t quotePattern = 0x2222222222222222ull;
+    bool inQuotes = false;
+    const char *p = line;
+
+    while (end - p >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+
+        uint32_t newlines = matchBytes(word, newlinePattern);
+        int result = processBlockMasks(index, (size_t)(p - line), matchBytes(word, commaPattern), newlines,
+                                       matchBytes(word, quotePattern), &inQuotes);
+        if (result < 0)
+            return NULL;
+        if (result > 0)
+            return p + countTrailingZeros(newlines);
+        p += 8;
+    }
+
+    return scanLineScalarFrom(p, end, line, index, &inQuotes);
+}
+#endif
+
+#ifdef CSV_SCAN_X86
+/**
+ * @brief SSE2扫描内核
+ * @details 每次比较16个字节
+ */
+__attribute__((target("sse2")))
+static const char *scanLineSse2(const char *line, const char *end, CsvLineIndex *index)
+{
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i quote = _mm_set1_epi8('"');
+    bool inQuotes = false;
+    const char *p = line;
+
+    while (end - p >= 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)p);
+        uint32_t commas = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, comma));
+        uint32_t newlines = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline));
+        uint32_t quotes = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, quote));
+
+        int result = processBlockMasks(index, (size_t)(p - line), commas, newlines, quotes, &inQuotes);
+        if (result < 0)
+            return NULL;
+        if (result > 0)
+            return p + countTrailingZeros(newlines);
+        p += 16;
+    }
+
+    return scanLineScalarFrom(p, end, line, index, &inQuotes);
+}
+
+/**
+ * @brief AVX2扫描内核
+ * @details 每次比较32个字节
+ */
+__attribute__((target("avx2")))
+static const char *scanLineAvx2(const char *line, const char *end, CsvLineIndex *index)
+{
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i quote = _mm256_set1_epi8('"');
+    bool inQuotes = false;
+    const char *p = line;
+
+    while (end - p >= 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)p);
+        uint32_t commas = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, comma));
+        uint32_t newlines = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline));
+        uint32_t quotes = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, quote));
+
+        int result = processBlockMasks(index, (size_t)(p - line), commas, newlines, quotes, &inQuotes);
+        if (result < 0)
+            return NULL;
+        if (result > 0)
+            return p + countTrailingZeros(newlines);
+        p += 32;
+    }
+
+    return scanLineScalarFrom(p, end, line, index, &inQuotes);
+}
+#endif
+
+/**
+ * @brief 逐字符校验UTF-8编码
+ * @details 按8字节一组跳过纯ASCII的部分，遇到多字节字符时解码检查：
+ *          后续字节必须为10xxxxxx，不允许超长编码、代理区（U+D800到U+DFFF）和超过U+10FFFF的码点
+ */
+static bool validateUtf8Scalar(const char *data, size_t length)
+{
+    const unsigned char *p = (const unsigned char *)data;
+    const unsigned char *end = p + length;
+
+    while (p < end)
+    {
+        if (end - p >= 8)
+        {
+            uint64_t word;
+            memcpy(&word, p, sizeof(word));
+            if ((word & 0x8080808080808080ull) == 0)
+            {
+                p += 8;
+                continue;
+            }
+        }
+
+        unsigned char lead = *p;
+        if (lead < 0x80)
+        {
+            p++;
+            continue;
+        }
+
+        size_t trailing;
+        uint32_t codePoint;
+        uint32_t minimum;
+        if ((lead & 0xE0) == 0xC0)
+        {
+            trailing = 1;
+            codePoint = lead & 0x1F;
+            minimum = 0x80;
+        }
+        else if ((lead & 0xF0) == 0xE0)
+        {
+            trailing = 2;
+            codePoint = lead & 0x0F;
+            minimum = 0x800;
+        }
+        else if ((lead & 0xF8) == 0xF0)
+        {
+            trailing = 3;
+            codePoint = lead & 0x07;
+            minimum = 0x10000;
+        }
+        else
+        {
+            return false;
+        }
+
+        if ((size_t)(end - p) <= trailing)
+            return false;
+        for (size_t i = 1; i <= trailing; i++)
+        {
+            if ((p[i] & 0xC0) != 0x80)
+                return false;
+            codePoint = (codePoint << 6) | (p[i] & 0x3F);
+        }
+        if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+            return false;
+
+        p += trailing + 1;
+    }
+
+    return true;
+}
+
+#ifdef CSV_SCAN_X86
+// 查表法UTF-8校验的错误类别：每个字节对（前一字节, 当前字节）查三张表，三个结果按位与后非零即为错误
+// 第3、4字节是否应为后续字节另行判断，见checkUtf8Block()
+#define UTF8_TOO_SHORT (1 << 0)       // 前导字节后缺少后续字节
+#define UTF8_TOO_LONG (1 << 1)        // ASCII之后出现后续字节
+#define UTF8_OVERLONG_3 (1 << 2)      // 三字节超长编码
+#define UTF8_TOO_LARGE (1 << 3)       // 码点超过U+10FFFF
+#define UTF8_SURROGATE (1 << 4)       // 代理区码点
+#define UTF8_OVERLONG_2 (1 << 5)      // 两字节超长编码
+#define UTF8_TOO_LARGE_1000 (1 << 6)  // 码点超过U+10FFFF（F4 90及以上）
+#define UTF8_OVERLONG_4 (1 << 6)      // 四字节超长编码
+#define UTF8_TWO_CONTS (1 << 7)       // 连续两个后续字节（是否合法取决于更前面的字节）
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+/**
+ * @brief 检查一个32字节块
+ * @param input 当前数据块
+ * @param previous 上一个数据块，提供跨块的前1到3个字节
+ * @return 错误掩码，全零表示没有发现错误
+ */
+__attribute__((target("avx2")))
+static inline __m256i checkUtf8Block(__m256i input, __m256i previous)
+{
+    // 前一字节的高4位
+    const __m256i byte1High = _mm256_setr_epi8(
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+        UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+        UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4);
+    // 前一字节的低4位
+    const __m256i byte1Low = _mm256_setr_epi8(
+        (char)(UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4),
+        (char)(UTF8_CARRY | UTF8_OVERLONG_2),
+        (char)UTF8_CARRY, (char)UTF8_CARRY,
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4),
+        (char)(UTF8_CARRY | UTF8_OVERLONG_2),
+        (char)UTF8_CARRY, (char)UTF8_CARRY,
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000));
+    // 当前字节的高4位
+    const __m256i byte2High = _mm256_setr_epi8(
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT);
+    const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+
+    // 把上一块的末尾拼到当前块前面，得到每个字节之前的第1、2、3个字节
+    __m256i spliced = _mm256_permute2x128_si256(previous, input, 0x21);
+    __m256i prev1 = _mm256_alignr_epi8(input, spliced, 15);
+    __m256i prev2 = _mm256_alignr_epi8(input, spliced, 14);
+    __m256i prev3 = _mm256_alignr_epi8(input, spliced, 13);
+
+    __m256i special = _mm256_and_si256(
+        _mm256_and_si256(
+            _mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lowNibble)),
+            _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, lowNibble))),
+        _mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), lowNibble)));
+
+    // 前2个字节是三/四字节前导（>=0xE0），或前3个字节是四字节前导（>=0xF0）时，当前字节必须是后续字节
+    __m256i isThird = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    __m256i isFourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    __m256i must23 = _mm256_and_si256(_mm256_or_si256(isThird, isFourth), _mm256_set1_epi8((char)0x80));
+    return _mm256_xor_si256(must23, special);
+}
+
+/**
+ * @brief 判断数据块是否以不完整的多字节字符结尾
+ * @return 末尾3个字节中存在需要更多后续字节的前导字节时，对应位置非零
+ */
+__attribute__((target("avx2")))
+static inline __m256i checkUtf8Incomplete(__m256i input)
+{
+    const __m256i maximum = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    return _mm256_subs_epu8(input, maximum);
+}
+
+/**
+ * @brief AVX2 UTF-8校验内核
+ * @details 查表法：每次检查32个字节，纯ASCII的块只需一次movemask；末尾不足32字节的部分补0后按同样方法检查
+ */
+__attribute__((target("avx2")))
+static bool validateUtf8Avx2(const char *data, size_t length)
+{
+    __m256i error = _mm256_setzero_si256();
+    __m256i previous = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+    size_t offset = 0;
+
+    for (; offset + 32 <= length; offset += 32)
+    {
+        __m256i input = _mm256_loadu_si256((const __m256i *)(data + offset));
+        if (_mm256_movemask_epi8(input) == 0)
+        {
+            // 全部是ASCII，只需确认上一块没有以不完整的字符结尾
+            error = _mm256_or_si256(error, incomplete);
+            incomplete = _mm256_setzero_si256();
+        }
+        else
+        {
+            error = _mm256_or_si256(error, checkUtf8Block(input, previous));
+            incomplete = checkUtf8Incomplete(input);
+        }
+        previous = input;
+    }
+
+    if (offset < length)
+    {
+        char tail[32] = {0};
+        memcpy(tail, data + offset, length - offset);
+        __m256i input = _mm256_loadu_si256((const __m256i *)tail);
+        error = _mm256_or_si256(error, checkUtf8Block(input, previous));
+        incomplete = checkUtf8Incomplete(input);
+    }
+
+    error = _mm256_or_si256(error, incomplete);
+    return _mm256_testz_si256(error, error) != 0;
+}
+#endif
+
+/**
+ * @brief 选择扫描内核
+ * @details 运行时检测CPU指令集，依次选用AVX2、SSE2或可移植的SWAR（按64位字并行比较）实现
+ *          UTF-8校验在支持AVX2时使用查表法内核，否则使用逐字符实现
+ * @note 多线程扫描前应在主线程调用一次；未调用时使用SWAR实现，结果相同
+ */
+void initCsvScanner()
+{
+#ifdef CSV_SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        activeKernel = scanLineAvx2;
+        activeUtf8Kernel = validateUtf8Avx2;
+        activeKernelName = "AVX2";
+        return;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        activeKernel = scanLineSse2;
+        activeKernelName = "SSE2";
+        return;
+    }
+#endif
+
+    activeKernel = scanLineSwar;
+    activeUtf8Kernel = validateUtf8Scalar;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    activeKernelName = "标量";
+#else
+    activeKernelName = "SWAR";
+#endif
+}
+
+/**
+ * @brief 获取当前扫描内核的名称
+ * @return "AVX2"、"SSE2"、"SWAR"或"标量"
+ */
+const char *getCsvScannerName()
+{
+    return activeKernelName;
+}
+
+/**
+ * @brief 初始化行索引
+ * @param index 要初始化的行索引
+ */
+void initCsvLineIndex(CsvLineIndex *index)
+{
+    index->delimiters = NULL;
+    index->count = 0;
+    index->capacity = 0;
+    index->length = 0;
+}
+
+/**
+ * @brief 释放行索引占用的内存
+ * @param index 行索引
+ */
+void freeCsvLineIndex(CsvLineIndex *index)
+{
+    free(index->delimiters);
+    initCsvLineIndex(index);
+}
+
+/**
+ * @brief 扫描一行并建立字段偏移索引
+ * @details 从line开始查找行尾换行符，同时记录行内所有作为分隔符的逗号相对行首的偏移
+ *          双引号括起的部分中的逗号不作为分隔符；行尾的回车符不计入行长度
+ * @param line 行起始位置
+ * @param end 数据结束位置
+ * @param index 输出参数，行索引（复用时覆盖原有内容，容量按需增长）
+ * @param nextLine 输出参数，下一行的起始位置
+ * @return 成功返回true，索引扩容失败（内存不足）返回false
+ * @note 行长度不受限制；第i个字段位于第i-1个和第i个分隔符之间
+ */
+bool indexCsvLine(const char *line, const char *end, CsvLineIndex *index, const char **nextLine)
+{
+    index->count = 0;
+
+    const char *lineEnd = activeKernel(line, end, index);
+    if (lineEnd == NULL)
+        return false;
+
+    *nextLine = lineEnd < end ? lineEnd + 1 : end;
+    if (lineEnd > line && lineEnd[-1] == '\r')
+        lineEnd--;
+    index->length = (size_t)(lineEnd - line);
+    return true;
+}
+
+/**
+ * @brief 校验UTF-8编码
+ * @details 检查数据是否为合法的UTF-8：不允许非法前导字节、缺少或多余的后续字节、
+ *          超长编码、代理区码点以及超过U+10FFFF的码点
+ * @param data 数据起始位置
+ * @param length 数据字节数
+ * @return 合法返回true
+ * @note 支持AVX2时每次检查32个字节，纯ASCII数据几乎没有额外开销
+ */
+bool validateUtf8(const char *data, size_t length)
+{
+    return activeUtf8Kernel(data, length);
+}
@@ -6,16 +6,24 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
 #ifdef _WIN32
+#include <windows.h>
 #include <direct.h>
+#include <fcntl.h>
 #include <io.h>
 #else
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
 #include "file_utils.h"
 
+// 已有文件重命名进来、尚未fsync的目录，空字符串表示没有
+static char pendingDirectory[MAX_PATH_LENGTH] = "";
+
 /**
  * @brief 检查文件是否存在
  * @details 使用access函数（Unix/Linux）或_access函数（Windows）检查文件是否存在且可读
@@ -64,4 +72,292 @@ bool createDirectory(const char *path)
 #else
     return mkdir(path, 0755) == 0;
 #endif
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 获取文件大小和修改时间
+ * @details 使用stat函数读取文件的大小和最后修改时间
+ * @param filename 文件路径
+ * @param size 输出参数，文件大小（字节），可以为NULL
+ * @param modifiedTime 输出参数，最后修改时间（秒），可以为NULL
+ * @return 成功返回true，文件不存在或无法访问时返回false
+ */
+bool getFileInfo(const char *filename, uint64_t *size, int64_t *modifiedTime)
+{
+    if (filename == NULL)
+        return false;
+
+    struct stat st;
+    if (stat(filename, &st) != 0)
+        return false;
+
+    if (size != NULL)
+        *size = (uint64_t)st.st_size;
+    if (modifiedTime != NULL)
+        *modifiedTime = (int64_t)st.st_mtime;
+    return true;
+}
+
+/**
+ * @brief 以只读方式映射整个文件
+ * @details 在Unix/Linux下使用mmap把文件映射到内存，不复制文件内容
+ *          在Windows下退化为把文件整体读入动态分配的缓冲区
+ * @param filename 文件路径
+ * @param size 输出参数，映射的字节数
+ * @return 指向文件内容的指针，文件不存在、为空或映射失败时返回NULL
+ * @note 使用完毕后必须调用unmapFile()释放
+ */
+const void *mapFile(const char *filename, size_t *size)
+{
+    if (filename == NULL || size == NULL)
+        return NULL;
+
+#ifdef _WIN32
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+        return NULL;
+
+    void *buffer = NULL;
+    long length = 0;
+    if (fseek(file, 0, SEEK_END) == 0 && (length = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0)
+    {
+        buffer = malloc((size_t)length);
+        if (buffer != NULL && fread(buffer, 1, (size_t)length, file) != (size_t)length)
+        {
+            free(buffer);
+            buffer = NULL;
+        }
+    }
+    fclose(file);
+
+    if (buffer != NULL)
+        *size = (size_t)length;
+    return buffer;
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // 映射建立后即可关闭文件描述符
+    if (data == MAP_FAILED)
+        return NULL;
+
+    *size = (size_t)st.st_size;
+    return data;
+#endif
+}
+
+/**
+ * @brief 释放mapFile()映射的文件
+ * @param data mapFile()返回的指针，为NULL时不做任何操作
+ * @param size mapFile()输出的字节数
+ */
+void unmapFile(const void *data, size_t size)
+{
+    if (data == NULL)
+        return;
+
+#ifdef _WIN32
+    (void)size;
+    free((void *)data);
+#else
+    munmap((void *)data, size);
+#endif
+}
+
+/**
+ * @brief 把文件内容写入磁盘
+ * @details 先刷新stdio缓冲区，再用fsync（Unix/Linux）或_commit（Windows）等待操作系统写入存储设备
+ * @param file 已打开的文件
+ * @return 成功返回true，否则返回false
+ * @note 返回true后即使断电，已写入的内容也不会丢失
+ */
+bool syncFile(FILE *file)
+{
+    if (file == NULL || fflush(file) != 0)
+        return false;
+
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+/**
+ * @brief 截断文件
+ * @details 把文件截断到指定长度，丢弃之后的内容
+ * @param filename 文件路径
+ * @param size 截断后的长度（字节）
+ * @return 成功返回true，文件不存在或无法写入时返回false
+ */
+bool truncateFile(const char *filename, uint64_t size)
+{
+    if (filename == NULL)
+        return false;
+
+#ifdef _WIN32
+    int fd = _open(filename, _O_WRONLY | _O_BINARY);
+    if (fd < 0)
+        return false;
+    bool truncated = _chsize_s(fd, (__int64)size) == 0;
+    _close(fd);
+    return truncated;
+#else
+    int fd = open(filename, O_WRONLY);
+    if (fd < 0)
+        return false;
+    bool truncated = ftruncate(fd, (off_t)size) == 0;
+    close(fd);
+    return truncated;
+#endif
+}
+
+/**
+ * @brief 打开原子保存的临时文件
+ * @details 在目标文件所在目录创建"目标文件名.tmp"，之后的内容都写入这个临时文件，目标文件保持不变
+ * @param atomic 输出参数，原子保存状态
+ * @param filename 目标文件路径
+ * @param mode 打开方式，"w"或"wb"
+ * @return 临时文件，路径过长或无法创建时返回NULL
+ * @note 写完后调用commitAtomicFile()替换目标文件，放弃保存时调用abortAtomicFile()
+ */
+FILE *openAtomicFile(AtomicFile *atomic, const char *filename, const char *mode)
+{
+    atomic->file = NULL;
+    int length = snprintf(atomic->temp, sizeof(atomic->temp), "%s%s", filename, ATOMIC_TEMP_SUFFIX);
+    if (length < 0 || (size_t)length >= sizeof(atomic->temp))
+        return NULL;
+    strcpy(atomic->target, filename);
+
+    atomic->file = fopen(atomic->temp, mode);
+    return atomic->file;
+}
+
+/**
+ * @brief 取得文件所在的目录
+ * @param filename 文件路径
+ * @param directory 输出参数，目录路径，文件路径不含目录时为"."
+ * @param size 输出缓冲区大小，不小于文件路径长度加1
+ */
+static void getParentDirectory(const char *filename, char *directory, size_t size)
+{
+    const char *slash = strrchr(filename, '/');
+#ifdef _WIN32
+    const char *backslash = strrchr(filename, '\\');
+    if (backslash != NULL && (slash == NULL || backslash > slash))
+        slash = backslash;
+#endif
+    if (slash == NULL)
+    {
+        snprintf(directory, size, ".");
+        return;
+    }
+
+    size_t length = (size_t)(slash - filename);
+    if (length == 0)
+        length = 1; // 根目录
+    snprintf(directory, size, "%.*s", (int)length, filename);
+}
+
+/**
+ * @brief 同步目录
+ * @details 在Unix/Linux下打开目录并fsync，使其中的文件创建、重命名和删除写入磁盘
+ *          Windows下重命名时已使用MOVEFILE_WRITE_THROUGH，不需要单独同步目录
+ * @param directory 目录路径
+ * @return 成功返回true，否则返回false
+ */
+static bool syncDirectory(const char *directory)
+{
+#ifdef _WIN32
+    (void)directory;
+    return true;
+#else
+    int fd = open(directory, O_RDONLY);
+    if (fd < 0)
+        return false;
+    bool synced = fsync(fd) == 0;
+    close(fd);
+    return synced;
+#endif
+}
+
+/**
+ * @brief 提交原子保存
+ * @details 关闭临时文件并把它重命名为目标文件，重命名是原子的，
+ *          任何时刻崩溃都只会留下完整的旧文件或完整的新文件
+ *          durable为true时先fsync临时文件，再在重命名之后把所在目录记为待同步
+ * @param atomic openAtomicFile()打开的原子保存状态
+ * @param durable 是否需要在断电后保留：可由其他文件重建的数据（如二进制快照）传false，省去fsync
+ * @return 成功返回true；写入、同步或重命名失败时删除临时文件并返回false，目标文件保持不变
+ * @note 目录的fsync推迟到syncPendingDirectory()，同一目录中连续保存的多个文件只同步一次目录
+ */
+bool commitAtomicFile(AtomicFile *atomic, bool durable)
+{
+    bool ok = !ferror(atomic->file);
+    if (ok && durable)
+        ok = syncFile(atomic->file);
+    ok = fclose(atomic->file) == 0 && ok;
+    atomic->file = NULL;
+
+#ifdef _WIN32
+    ok = ok && MoveFileExA(atomic->temp, atomic->target, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+    ok = ok && rename(atomic->temp, atomic->target) == 0;
+#endif
+    if (!ok)
+    {
+        remove(atomic->temp);
+        return false;
+    }
+
+    if (durable)
+    {
+        // 待同步的是另一个目录时先把它同步，只记录一个目录
+        char directory[MAX_PATH_LENGTH];
+        getParentDirectory(atomic->target, directory, sizeof(directory));
+        if (pendingDirectory[0] != '\0' && strcmp(pendingDirectory, directory) != 0)
+            syncPendingDirectory();
+        strcpy(pendingDirectory, directory);
+    }
+    return true;
+}
+
+/**
+ * @brief 放弃原子保存
+ * @details 关闭并删除临时文件，目标文件保持不变
+ * @param atomic openAtomicFile()打开的原子保存状态
+ */
+void abortAtomicFile(AtomicFile *atomic)
+{
+    if (atomic->file != NULL)
+    {
+        fclose(atomic->file);
+        atomic->file = NULL;
+    }
+    remove(atomic->temp);
+}
+
+/**
+ * @brief 同步待同步的目录
+ * @details 对commitAtomicFile()之后尚未同步的目录调用一次fsync，使其中的重命名在断电后也能保留
+ * @return 成功（或没有待同步的目录）返回true，否则返回false
+ * @note 在一组文件保存完毕后调用；删除依赖这些文件的数据（如变更日志）之前也必须调用
+ */
+bool syncPendingDirectory()
+{
+    if (pendingDirectory[0] == '\0')
+        return true;
+
+    bool synced = syncDirectory(pendingDirectory);
+    pendingDirectory[0] = '\0';
+    return synced;
+}
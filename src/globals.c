@@ -7,9 +7,11 @@
 #include "globals.h"
 
 // 全局变量定义
-Student students[MAX_STUDENTS];             // 学生数组
+Student *students = NULL;                   // 学生数组（动态扩容）
 User users[MAX_USERS];                      // 用户数组
 int studentCount = 0;                       // 当前学生数量
+int studentCapacity = 0;                    // 学生数组当前容量
+StudentColumns studentColumns = {0};        // 学生成绩列式视图
 int userCount = 0;                          // 当前用户数量
 char currentUser[MAX_USERNAME_LENGTH] = ""; // 当前登录用户
 bool isCurrentUserAdmin = false;            // 当前用户是否为管理员
@@ -29,4 +31,7 @@ int currentSortCriteria = 0;               // 当前排序依据
 int currentSortOrder = 0;                  // 当前排序顺序
 
 // 统计缓存
-StatisticsCache statsCache = {false, {0}, {0}, {{0}}, 0, 0}; // 统计分析缓存
\ No newline at end of file
+StatisticsCache statsCache = {false, {0}, {0}, NULL, 0, 0, 0, {0}}; // 统计分析缓存
+
+// 运行时选项
+RuntimeOptions runtimeOptions = {false, 0, false, LOAD_COLUMNS_ALL, JOURNAL_COMPACT_RECORDS, AUTOSAVE_INTERVAL_MS, AUTOSAVE_CHANGES, false};   // 命令行指定的运行时选项
\ No newline at end of file
@@ -15,6 +15,11 @@
 #include "io_utils.h"
 #include "config.h"
 #include "string_utils.h"
+#include "math_utils.h"
+#include "validation.h"
+
+// 当前线程的消息暂存文件，为NULL时消息直接写到stdout
+static _Thread_local FILE *captureStream = NULL;
 
 /**
  * @brief 清理输入缓冲区
@@ -159,6 +164,36 @@ float safeInputFloat(const char *prompt, float min, float max)
     }
 }
 
+/**
+ * @brief 安全输入成绩
+ * @details 读取用户输入的成绩并直接解析为定点成绩，范围为MIN_SCORE到MAX_SCORE
+ *          循环直到获得有效输入
+ * @param prompt 显示给用户的提示信息
+ * @return 返回用户输入的有效定点成绩（百分之一分）
+ * @note 输入文本按十进制解析，不经过浮点数，第三位小数四舍五入
+ * @see parseScore(), isValidScore()
+ */
+Score safeInputScore(const char *prompt)
+{
+    char buffer[100];
+
+    while (1)
+    {
+        printf("%s (%.1f-%.1f): ", prompt, MIN_SCORE, MAX_SCORE);
+
+        if (fgets(buffer, sizeof(buffer), stdin) != NULL)
+        {
+            int32_t value;
+            if (parseScore(buffer, &value) && isValidScore(value))
+            {
+                return (Score)value;
+            }
+        }
+
+        printError("输入无效，请重新输入！");
+    }
+}
+
 /**
  * @brief 安全输入字符串
  * @details 提供安全的字符串输入功能，包含空值检查和自动去除首尾空格
@@ -203,7 +238,7 @@ void safeInputString(const char *prompt, char *buffer, int maxLen)
  */
 void printColored(const char *text, const char *color)
 {
-    printf("%s%s%s", color, text, COLOR_RESET);
+    fprintf(messageStream(), "%s%s%s", color, text, COLOR_RESET);
 }
 
 /**
@@ -215,7 +250,7 @@ void printColored(const char *text, const char *color)
 void printSuccess(const char *message)
 {
     printColored(message, COLOR_GREEN);
-    printf("\n");
+    fputc('\n', messageStream());
 }
 
 /**
@@ -227,7 +262,7 @@ void printSuccess(const char *message)
 void printError(const char *message)
 {
     printColored(message, COLOR_RED);
-    printf("\n");
+    fputc('\n', messageStream());
 }
 
 /**
@@ -239,7 +274,7 @@ void printError(const char *message)
 void printWarning(const char *message)
 {
     printColored(message, COLOR_YELLOW);
-    printf("\n");
+    fputc('\n', messageStream());
 }
 
 /**
@@ -251,7 +286,7 @@ void printWarning(const char *message)
 void printInfo(const char *message)
 {
     printColored(message, COLOR_CYAN);
-    printf("\n");
+    fputc('\n', messageStream());
 }
 
 /**
@@ -285,4 +320,62 @@ char safeInputChar(const char *prompt)
         
         printError("请输入单个字符！");
     }
+}
+
+/**
+ * @brief 获取当前线程的消息输出流
+ * @details 当前线程调用beginOutputCapture()之后返回其暂存文件，否则返回stdout
+ * @return 消息输出流
+ * @note printSuccess、printError等消息函数都写入此流；可能在后台线程中执行的代码
+ *       输出附加信息时应使用fprintf(messageStream(), ...)而不是printf
+ */
+FILE *messageStream()
+{
+    return captureStream != NULL ? captureStream : stdout;
+}
+
+/**
+ * @brief 开始暂存当前线程的消息
+ * @details 创建临时文件，之后当前线程写入messageStream()的内容都先存入其中，
+ *          避免后台线程的输出与前台的输入提示交织在一起
+ * @return 成功返回true；临时文件无法创建时返回false，消息照常直接输出
+ */
+bool beginOutputCapture()
+{
+    if (captureStream == NULL)
+    {
+        captureStream = tmpfile();
+    }
+    return captureStream != NULL;
+}
+
+/**
+ * @brief 结束暂存当前线程的消息
+ * @return 暂存文件，交给replayCapturedOutput()输出；没有在暂存时返回NULL
+ */
+FILE *endOutputCapture()
+{
+    FILE *captured = captureStream;
+    captureStream = NULL;
+    return captured;
+}
+
+/**
+ * @brief 输出暂存的消息
+ * @details 把暂存文件的内容按原顺序写到stdout，然后关闭文件
+ * @param captured endOutputCapture()返回的暂存文件，为NULL时不做任何事
+ */
+void replayCapturedOutput(FILE *captured)
+{
+    if (captured == NULL)
+        return;
+
+    char buffer[4096];
+    size_t length;
+    rewind(captured);
+    while ((length = fread(buffer, 1, sizeof(buffer), captured)) > 0)
+    {
+        fwrite(buffer, 1, length, stdout);
+    }
+    fclose(captured);
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 * @details 学生成绩管理系统的主入口函数，负责系统初始化、用户登录验证、
 *          主菜单循环处理和系统清理等核心流程
 *          程序流程：设置编码 -> 系统初始化 -> 用户登录 -> 主菜单循环 -> 数据保存 -> 系统清理
+*          学生数据在系统初始化时开始后台加载，与用户登录并发进行，登录成功后等待加载完成
 * @return 程序退出状态码：0表示正常退出，-1表示异常退出
 * @note 系统预设用户账户：
 *   1. admin - 密码：123456（管理员权限）
@@ -40,8 +41,11 @@
 #include "system_utils.h"
 #include "core_handlers.h"
 #include "student_io.h"
+#include "student_heap.h"
+#include "student_journal.h"
+#include "file_utils.h"
 
-int main()
+int main(int argc, char *argv[])
 {
     // 设置控制台编码为UTF-8
 #ifdef _WIN32
@@ -50,6 +54,9 @@ int main()
     SetConsoleCP(65001);        // 设置控制台输入编码
 #endif
 
+    // 解析命令行选项
+    parseCommandLineOptions(argc, argv);
+
     // 初始化系统
     if (!initializeSystem())
     {
@@ -77,6 +84,9 @@ int main()
             printSuccess("登录成功！");
             printf("欢迎您，%s%s\n", currentUser,
                    isCurrentUserAdmin ? " (管理员)" : " (普通用户)");
+
+            // 主菜单显示学生总数，进入之前等待后台加载完成
+            waitForStudentData();
             pauseSystem();
             break;
         }
@@ -128,14 +138,33 @@ int main()
             }
             break;
         case MENU_EXIT:
+            // 先写完后台待写入的变更，写入失败时dataModified被设置，改为完整保存
+            flushStudentJournal();
+
             // 保存数据并退出
             if (dataModified)
             {
                 printInfo("正在保存数据...");
                 saveStudentsToFile();
                 saveUsersToFile();
+                if (runtimeOptions.persistentHeap)
+                {
+                    saveStudentHeap();
+                }
+                syncPendingDirectory(); // 几个文件的重命名只同步一次目录
                 printSuccess("数据保存完成！");
             }
+            else if (studentJournalNeedsCompaction())
+            {
+                // 变更日志较长时压缩为新的CSV文件和快照，日志随之清空
+                printInfo("正在压缩变更日志...");
+                saveStudentsToFile();
+                if (runtimeOptions.persistentHeap)
+                {
+                    saveStudentHeap();
+                }
+                syncPendingDirectory();
+            }
             printInfo("感谢使用学生成绩管理系统！");
             break;
         default:
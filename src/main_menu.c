@@ -79,6 +79,7 @@ void displayBasicFunctionsMenu()
  *       2. 成绩分布统计
  *       3. 分数段统计
  *       4. 综合统计分析
+ *       5. 外部文件流式统计
  *       0. 返回主菜单
  */
 void displayStatisticsMenu()
@@ -89,6 +90,7 @@ void displayStatisticsMenu()
 	printf("2. 成绩分布统计\n");
 	printf("3. 分数段统计\n");
 	printf("4. 综合统计分析\n");
+	printf("5. 外部文件流式统计\n");
 	printf("0. 返回主菜单\n");
 	printf("\n");
 	printf("当前学生总数: %d\n", studentCount);
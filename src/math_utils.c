@@ -4,7 +4,12 @@
  * @note 实现数学计算相关函数
  */
 
+#include <string.h>
 #include "math_utils.h"
+#include "config.h"
+
+// parseScoreField()按两位小数直接累加，要求定点成绩以百分之一分为单位
+_Static_assert(SCORE_SCALE == 100, "parseScoreField assumes two fractional digits");
 
 /**
  * @brief 计算平均值
@@ -28,4 +33,248 @@ float calculateAverage(float scores[], int count)
     }
 
     return sum / count;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 定点成绩转换为浮点数
+ * @details 用于显示和需要浮点运算（如标准差）的场合
+ * @param score 定点成绩（百分之一分），也可以是定点总分
+ * @return 对应的分数值
+ */
+float scoreToFloat(int32_t score)
+{
+    return (float)score / SCORE_SCALE;
+}
+
+/**
+ * @brief 浮点分数转换为定点成绩
+ * @details 按百分之一分四舍五入
+ * @param value 分数值
+ * @return 定点成绩（百分之一分）
+ */
+int32_t scoreFromFloat(float value)
+{
+    float scaled = value * SCORE_SCALE;
+    return (int32_t)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+}
+
+/**
+ * @brief 解析成绩文本
+ * @details 将"88.5"、"88.50"等十进制文本直接解析为定点成绩，不经过浮点数
+ *          第三位小数四舍五入，允许前后空白（包括行尾换行符）
+ * @param text 成绩文本
+ * @param score 输出参数，解析得到的定点成绩（百分之一分）
+ * @return 格式正确返回true，否则返回false且不修改score
+ * @note 只检查格式，不检查分数范围，范围检查请使用isValidScore()
+ */
+bool parseScore(const char *text, int32_t *score)
+{
+    return parseScoreSpan(text, strlen(text), score);
+}
+
+/**
+ * @brief 解析指定长度的成绩文本
+ * @details 与parseScore()规则相同，但只读取text开始的length个字节，文本不需要以'\0'结尾
+ * @param text 成绩文本起始地址
+ * @param length 文本字节数
+ * @param score 输出参数，解析得到的定点成绩（百分之一分）
+ * @return 格式正确返回true，否则返回false且不修改score
+ * @note 用于直接解析映射文件中的字段，无需先把字段复制为字符串
+ */
+bool parseScoreSpan(const char *text, size_t length, int32_t *score)
+{
+    const char *p = text;
+    const char *end = text + length;
+    while (p < end && (*p == ' ' || *p == '\t'))
+        p++;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = *p == '-';
+        p++;
+    }
+
+    int64_t whole = 0;
+    int digitCount = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        whole = whole * 10 + (*p - '0');
+        if (whole > INT32_MAX / SCORE_SCALE)
+            return false;
+        digitCount++;
+        p++;
+    }
+
+    // 保留三位小数用于四舍五入，更多的小数位直接忽略
+    int fraction = 0;
+    int fractionDigits = 0;
+    if (p < end && *p == '.')
+    {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9')
+        {
+            if (fractionDigits < 3)
+            {
+                fraction = fraction * 10 + (*p - '0');
+                fractionDigits++;
+            }
+            digitCount++;
+            p++;
+        }
+    }
+
+    if (digitCount == 0)
+        return false;
+
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+        p++;
+    if (p != end)
+        return false;
+
+    while (fractionDigits < 3)
+    {
+        fraction *= 10;
+        fractionDigits++;
+    }
+
+    int64_t value = whole * SCORE_SCALE + (fraction + 5) / 10;
+    if (value > INT32_MAX)
+        return false;
+
+    *score = (int32_t)(negative ? -value : value);
+    return true;
+}
+
+/**
+ * @brief 快速解析CSV成绩字段
+ * @details 专用于数据文件中的成绩格式：非负十进制数，最多两位小数（如"88"、"88.5"、"88.50"）
+ *          不接受正负号、空白、指数和三位以上小数，逐字符直接累加为定点数
+ * @param text 字段起始地址（不需要以'\0'结尾）
+ * @param length 字段字节数
+ * @param score 输出参数，定点成绩（百分之一分）
+ * @return 格式正确返回true，否则返回false且不修改score
+ * @note 只检查格式，范围由调用者根据字段含义检查
+ */
+bool parseScoreField(const char *text, size_t length, int32_t *score)
+{
+    const char *p = text;
+    const char *end = text + length;
+
+    // 整数部分最多7位，保证乘以SCORE_SCALE后不溢出
+    int32_t whole = 0;
+    const char *digitsEnd = length < 7 ? end : text + 7;
+    while (p < digitsEnd && (unsigned)(*p - '0') <= 9)
+    {
+        whole = whole * 10 + (*p - '0');
+        p++;
+    }
+    if (p == text)
+        return false;
+
+    int32_t fraction = 0;
+    if (p < end)
+    {
+        // 小数点后必须有一到两位数字
+        size_t fractionDigits = (size_t)(end - p) - 1;
+        if (*p != '.' || fractionDigits == 0 || fractionDigits > 2)
+            return false;
+        if ((unsigned)(p[1] - '0') > 9)
+            return false;
+        fraction = (p[1] - '0') * 10;
+        if (fractionDigits == 2)
+        {
+            if ((unsigned)(p[2] - '0') > 9)
+                return false;
+            fraction += p[2] - '0';
+        }
+    }
+
+    *score = whole * SCORE_SCALE + fraction;
+    return true;
+}
+
+/**
+ * @brief 快速解析CSV小整数字段
+ * @details 专用于年龄、课程数量等字段：只由数字组成，最多9位
+ * @param text 字段起始地址（不需要以'\0'结尾）
+ * @param length 字段字节数
+ * @param value 输出参数，解析得到的整数
+ * @return 格式正确返回true，否则返回false且不修改value
+ * @note 只检查格式，范围由调用者根据字段含义检查
+ */
+bool parseIntegerField(const char *text, size_t length, int *value)
+{
+    if (length == 0 || length > 9)
+        return false;
+
+    int result = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        unsigned digit = (unsigned)(text[i] - '0');
+        if (digit > 9)
+            return false;
+        result = result * 10 + (int)digit;
+    }
+
+    *value = result;
+    return true;
+}
+
+/**
+ * @brief 格式化定点成绩
+ * @details 将定点成绩格式化为两位小数的文本，输出与printf("%.2f")一致
+ * @param buffer 输出缓冲区，长度至少为SCORE_TEXT_SIZE
+ * @param score 定点成绩（百分之一分），也可以是定点总分
+ * @return 写入的字符数（不含终止符）
+ * @note 只使用整数运算，要求SCORE_SCALE为100
+ */
+int formatScore(char *buffer, int32_t score)
+{
+    char *p = buffer;
+    uint32_t magnitude = (uint32_t)score;
+    if (score < 0)
+    {
+        *p++ = '-';
+        magnitude = 0u - magnitude;
+    }
+
+    uint32_t whole = magnitude / SCORE_SCALE;
+    uint32_t fraction = magnitude % SCORE_SCALE;
+
+    // 整数部分逆序生成后再正序写出
+    char digits[10];
+    int n = 0;
+    do
+    {
+        digits[n++] = (char)('0' + whole % 10);
+        whole /= 10;
+    } while (whole != 0);
+    while (n > 0)
+    {
+        *p++ = digits[--n];
+    }
+
+    *p++ = '.';
+    *p++ = (char)('0' + fraction / 10);
+    *p++ = (char)('0' + fraction % 10);
+    *p = '\0';
+
+    return (int)(p - buffer);
+}
+
+/**
+ * @brief 计算定点平均分
+ * @details 用整数运算计算总分除以课程数的结果，按百分之一分四舍五入
+ * @param total 定点总分
+ * @param count 课程数量
+ * @return 定点平均分，count为0时返回0
+ */
+Score calculateAverageScore(ScoreTotal total, int count)
+{
+    if (count <= 0)
+        return 0;
+
+    // 分子分母同乘2后加上分母的一半，实现四舍五入
+    return (Score)((2 * (int64_t)total + count) / (2 * count));
+}
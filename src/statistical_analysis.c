@@ -18,11 +18,86 @@
 #include "student_crud.h"
 #include "student_search.h"
 #include "student_sort.h"
+#include "course_dict.h"
+#include "student_store.h"
+#include "student_id.h"
+
+/**
+ * @brief 累计一个课程成绩
+ * @details 将一个成绩计入课程统计，及格人数暂存在passRate字段中
+ * @param stats 课程统计结构体
+ * @param score 课程成绩（定点）
+ */
+static void addCourseScore(CourseStats *stats, Score score)
+{
+    if (stats->studentCount == 0 || score > stats->maxScore)
+        stats->maxScore = score;
+    if (stats->studentCount == 0 || score < stats->minScore)
+        stats->minScore = score;
+    stats->totalScore += score;
+    if (score >= (Score)(PASS_SCORE * SCORE_SCALE))
+        stats->passRate += 1;
+    stats->studentCount++;
+}
+
+/**
+ * @brief 完成课程统计
+ * @details 根据累计结果计算平均分，并把暂存的及格人数换算为及格率
+ * @param stats 课程统计结构体
+ */
+static void finishCourseStats(CourseStats *stats)
+{
+    if (stats->studentCount == 0)
+        return;
+
+    // 定点总分精确累计，只在最后一步换算为浮点平均分
+    stats->averageScore = (float)((double)stats->totalScore / stats->studentCount / SCORE_SCALE);
+    stats->passRate = stats->passRate / stats->studentCount * 100;
+}
+
+/**
+ * @brief 统计当前有学生选修的课程数
+ * @return 不重复的课程数量
+ * @note 按课程编号标记，单次遍历完成，无需字符串比较
+ */
+static int countCoursesInUse()
+{
+    if (!ensureCourseColumns())
+        return 0;
+
+    int dictSize = getCourseDictSize();
+    if (dictSize == 0)
+        return 0;
+
+    bool *used = calloc((size_t)dictSize, sizeof(bool));
+    if (used == NULL)
+        return 0;
+
+    int count = 0;
+    const StudentColumns *columns = &studentColumns;
+    for (int j = 0; j < MAX_COURSES; j++)
+    {
+        for (int i = 0; i < studentCount; i++)
+        {
+            if (j >= columns->courseCount[i])
+                continue;
+            CourseId id = columns->courseIds[j][i];
+            if (!used[id])
+            {
+                used[id] = true;
+                count++;
+            }
+        }
+    }
+
+    free(used);
+    return count;
+}
 
 /**
  * @brief 显示课程统计信息
  * @details 统计并显示所有课程的详细信息，包括每门课程的人数、最高分、最低分、平均分和及格率
- *          自动收集系统中所有不重复的课程名称，并为每门课程计算统计数据
+ *          按课程字典中的编号一次遍历累计所有课程的统计数据
  * @note 显示内容包括：
  *       - 课程名称
  *       - 选课人数
@@ -42,113 +117,126 @@ void displayCourseStatistics()
         return;
     }
 
-    // 收集所有课程名称
-    char courses[MAX_STUDENTS * MAX_COURSES][MAX_COURSE_NAME_LENGTH];
-    int courseCount = 0;
+    // 按列投影加载时先补齐课程列，课程字典可能因此扩大
+    if (!ensureCourseColumns())
+    {
+        printError("内存不足，无法计算课程统计！");
+        pauseSystem();
+        return;
+    }
 
-    for (int i = 0; i < studentCount; i++)
+    // 一次遍历计算所有课程的统计数据
+    int dictSize = getCourseDictSize();
+    CourseStats *courseStats = dictSize > 0 ? calloc((size_t)dictSize, sizeof(CourseStats)) : NULL;
+    bool hasCourse = false;
+    if (courseStats != NULL)
     {
-        for (int j = 0; j < students[i].courseCount; j++)
+        calculateAllCourseStats(courseStats);
+        for (int id = 0; id < dictSize && !hasCourse; id++)
         {
-            bool exists = false;
-            for (int k = 0; k < courseCount; k++)
-            {
-                if (strcmp(courses[k], students[i].courses[j]) == 0)
-                {
-                    exists = true;
-                    break;
-                }
-            }
-            if (!exists)
-            {
-                strncpy(courses[courseCount], students[i].courses[j], MAX_COURSE_NAME_LENGTH - 1);
-                courses[courseCount][MAX_COURSE_NAME_LENGTH - 1] = '\0';
-                courseCount++;
-            }
+            hasCourse = courseStats[id].studentCount > 0;
         }
     }
 
-    if (courseCount == 0)
+    if (!hasCourse)
     {
+        free(courseStats);
         printWarning("暂无课程数据！");
         pauseSystem();
         return;
     }
 
+    printCourseStatsTable(courseStats, dictSize);
+
+    free(courseStats);
+    pauseSystem();
+}
+
+/**
+ * @brief 输出课程统计表
+ * @details 按课程编号顺序逐行输出课程名称、人数、最高分、最低分、平均分和及格率
+ * @param stats 课程统计数组，按课程编号索引
+ * @param count 数组长度
+ * @note 人数为0的课程（已登记但无人选修）不输出
+ */
+void printCourseStatsTable(const CourseStats *stats, int count)
+{
     printf("\n");
     printf("%-14s %-8s %-11s %-11s %-11s %-11s\n",
            "课程名称", "人数", "最高分", "最低分", "平均分", "及格率");
     printf("========================================\n");
 
-    for (int i = 0; i < courseCount; i++)
+    for (int id = 0; id < count; id++)
     {
-        CourseStats stats = calculateCourseStats(courses[i]);
+        if (stats[id].studentCount == 0)
+            continue; // 已登记但当前无人选修的课程
         printf("%-12s %-6d %-8.2f %-8.2f %-8.2f %-7.2f%%\n",
-               courses[i], stats.studentCount, stats.maxScore,
-               stats.minScore, stats.averageScore, stats.passRate);
+               getCourseName(id), stats[id].studentCount, scoreToFloat(stats[id].maxScore),
+               scoreToFloat(stats[id].minScore), stats[id].averageScore, stats[id].passRate);
     }
-
-    pauseSystem();
 }
 
 /**
  * @brief 计算课程统计信息
  * @details 计算指定课程的详细统计数据，包括选课人数、分数统计和及格率
- * @param courseName 要统计的课程名称
+ * @param courseId 要统计的课程编号（课程字典中的编号）
  * @return CourseStats 包含课程统计信息的结构体
  * @note 统计内容包括：
  *       - studentCount: 选课学生数量
  *       - maxScore, minScore: 最高分和最低分
  *       - totalScore, averageScore: 总分和平均分
  *       - passRate: 及格率（百分比）
+ * @note 按整数编号匹配课程，不做字符串比较
+ * @note 按列投影加载时，调用者须先调用ensureCourseColumns()
  * @warning 如果课程不存在，返回全零的统计结构体
  */
-CourseStats calculateCourseStats(const char *courseName)
+CourseStats calculateCourseStats(int courseId)
 {
     CourseStats stats = {0};
-    float scores[MAX_STUDENTS];
-    int count = 0;
+    const StudentColumns *columns = &studentColumns;
 
-    // 收集该课程的所有分数
     for (int i = 0; i < studentCount; i++)
     {
-        for (int j = 0; j < students[i].courseCount; j++)
+        for (int j = 0; j < columns->courseCount[i]; j++)
         {
-            if (strcmp(students[i].courses[j], courseName) == 0)
+            if (columns->courseIds[j][i] == courseId)
             {
-                scores[count] = students[i].scores[j];
-                count++;
+                addCourseScore(&stats, columns->courseScores[j][i]);
                 break;
             }
         }
     }
 
-    if (count == 0)
-        return stats;
-
-    stats.studentCount = count;
-    stats.maxScore = scores[0];
-    stats.minScore = scores[0];
-    stats.totalScore = 0;
-
-    int passCount = 0;
+    finishCourseStats(&stats);
+    return stats;
+}
 
-    for (int i = 0; i < count; i++)
+/**
+ * @brief 计算所有课程的统计信息
+ * @details 一次遍历所有学生，按课程编号同时累计每门课程的统计数据
+ * @param stats 输出数组，长度至少为getCourseDictSize()，按课程编号索引，调用前需清零
+ * @note 时间复杂度O(学生数×课程数)，与课程种类数无关
+ * @note 按列投影加载时，调用者须先调用ensureCourseColumns()，再按课程字典大小分配stats
+ * @see calculateCourseStats()
+ */
+void calculateAllCourseStats(CourseStats *stats)
+{
+    // 按课程位置逐列扫描，每一轮只读取连续的编号列和成绩列
+    const StudentColumns *columns = &studentColumns;
+    for (int j = 0; j < MAX_COURSES; j++)
     {
-        if (scores[i] > stats.maxScore)
-            stats.maxScore = scores[i];
-        if (scores[i] < stats.minScore)
-            stats.minScore = scores[i];
-        stats.totalScore += scores[i];
-
-        if (scores[i] >= PASS_SCORE)
-            passCount++;
+        for (int i = 0; i < studentCount; i++)
+        {
+            if (j < columns->courseCount[i])
+                addCourseScore(&stats[columns->courseIds[j][i]], columns->courseScores[j][i]);
+        }
     }
 
-    stats.averageScore = stats.totalScore / count;
-    stats.passRate = (float)passCount / count * 100;
-
-    return stats;
+    int dictSize = getCourseDictSize();
+    for (int id = 0; id < dictSize; id++)
+    {
+        finishCourseStats(&stats[id]);
+    }
 }
 
 /**
@@ -177,29 +265,39 @@ void displayScoreDistribution()
 
     // 使用缓存的分数分布数据
     ScoreDistribution dist = getCachedScoreDistribution();
+    printScoreDistribution(&dist, studentCount);
+
+    pauseSystem();
+}
 
+/**
+ * @brief 输出分数分布
+ * @details 输出各分数段的人数和百分比，以及及格和不及格人数
+ * @param dist 分数分布
+ * @param total 总人数（大于0）
+ */
+void printScoreDistribution(const ScoreDistribution *dist, int total)
+{
     printf("\n分数段分布：\n");
     printSeparator();
-    printf("90-100分: %d人 (%.2f%%)\n", dist.excellent,
-           (float)dist.excellent / studentCount * 100);
-    printf("80-89分:  %d人 (%.2f%%)\n", dist.good,
-           (float)dist.good / studentCount * 100);
-    printf("70-79分:  %d人 (%.2f%%)\n", dist.medium,
-           (float)dist.medium / studentCount * 100);
-    printf("60-69分:  %d人 (%.2f%%)\n", dist.pass,
-           (float)dist.pass / studentCount * 100);
-    printf("0-59分:   %d人 (%.2f%%)\n", dist.fail,
-           (float)dist.fail / studentCount * 100);
+    printf("90-100分: %d人 (%.2f%%)\n", dist->excellent,
+           (float)dist->excellent / total * 100);
+    printf("80-89分:  %d人 (%.2f%%)\n", dist->good,
+           (float)dist->good / total * 100);
+    printf("70-79分:  %d人 (%.2f%%)\n", dist->medium,
+           (float)dist->medium / total * 100);
+    printf("60-69分:  %d人 (%.2f%%)\n", dist->pass,
+           (float)dist->pass / total * 100);
+    printf("0-59分:   %d人 (%.2f%%)\n", dist->fail,
+           (float)dist->fail / total * 100);
 
     printf("\n总体统计：\n");
-    printf("总人数: %d\n", studentCount);
+    printf("总人数: %d\n", total);
     printf("及格人数: %d (%.2f%%)\n",
-           studentCount - dist.fail,
-           (float)(studentCount - dist.fail) / studentCount * 100);
+           total - dist->fail,
+           (float)(total - dist->fail) / total * 100);
     printf("不及格人数: %d (%.2f%%)\n",
-           dist.fail, (float)dist.fail / studentCount * 100);
-
-    pauseSystem();
+           dist->fail, (float)dist->fail / total * 100);
 }
 
 /**
@@ -212,37 +310,30 @@ void displayScoreDistribution()
  *       - medium: 70-79分
  *       - pass: 60-69分
  *       - fail: 0-59分
+ * @note 顺序扫描平均分列，按“不低于各分数线”的人数累计，循环体无分支便于编译器向量化
  */
 ScoreDistribution calculateScoreDistribution()
 {
     ScoreDistribution dist = {0};
+    const Score *averages = studentColumns.averageScore;
+    int atLeast90 = 0, atLeast80 = 0, atLeast70 = 0, atLeast60 = 0;
 
+    // 定点整数比较，循环中没有浮点运算
     for (int i = 0; i < studentCount; i++)
     {
-        float avgScore = students[i].averageScore;
-
-        if (avgScore >= 90)
-        {
-            dist.excellent++;
-        }
-        else if (avgScore >= 80)
-        {
-            dist.good++;
-        }
-        else if (avgScore >= 70)
-        {
-            dist.medium++;
-        }
-        else if (avgScore >= 60)
-        {
-            dist.pass++;
-        }
-        else
-        {
-            dist.fail++;
-        }
+        Score avgScore = averages[i];
+        atLeast90 += avgScore >= 90 * SCORE_SCALE;
+        atLeast80 += avgScore >= 80 * SCORE_SCALE;
+        atLeast70 += avgScore >= 70 * SCORE_SCALE;
+        atLeast60 += avgScore >= 60 * SCORE_SCALE;
     }
 
+    dist.excellent = atLeast90;
+    dist.good = atLeast80 - atLeast90;
+    dist.medium = atLeast70 - atLeast80;
+    dist.pass = atLeast60 - atLeast70;
+    dist.fail = studentCount - atLeast60;
+
     return dist;
 }
 
@@ -267,8 +358,8 @@ void displayStudentRanking()
     }
 
     // 使用缓存的排名数据
-    StudentRank rankings[MAX_STUDENTS];
-    int rankingCount = getCachedStudentRankings(rankings);
+    const StudentRank *rankings = NULL;
+    int rankingCount = getCachedStudentRankings(&rankings);
 
     printf("\n");
     // 调整中文表头的对齐格式，考虑中文字符的显示宽度
@@ -278,13 +369,16 @@ void displayStudentRanking()
 
     for (int i = 0; i < rankingCount; i++)
     {
-        int idx = rankings[i].studentIndex;
+        // 排名中保存的是句柄，需要解析出当前下标
+        int idx = resolveStudentHandle(rankings[i].handle);
+        if (idx < 0)
+            continue;
         printf("%-5d %-10s %-12s %-8.2f %-8.2f\n",
                i + 1,
                students[idx].studentID,
-               students[idx].name,
-               students[idx].totalScore,
-               students[idx].averageScore);
+               getStudentDetail(&students[idx])->name,
+               scoreToFloat(students[idx].totalScore),
+               scoreToFloat(students[idx].averageScore));
     }
 
     pauseSystem();
@@ -314,29 +408,38 @@ void displayOverallStatistics()
 
     // 使用缓存的总体统计数据
     OverallStats stats = getCachedOverallStats();
+    printOverallStats(&stats);
+
+    pauseSystem();
+}
 
+/**
+ * @brief 输出总体统计
+ * @details 依次输出学生信息统计、成绩统计和课程统计三部分
+ * @param stats 总体统计（totalStudents大于0）
+ */
+void printOverallStats(const OverallStats *stats)
+{
     printf("\n学生信息统计：\n");
     printSeparator();
-    printf("总学生数: %d\n", stats.totalStudents);
-    printf("男学生数: %d (%.2f%%)\n", stats.maleCount,
-           (float)stats.maleCount / stats.totalStudents * 100);
-    printf("女学生数: %d (%.2f%%)\n", stats.femaleCount,
-           (float)stats.femaleCount / stats.totalStudents * 100);
-    printf("平均年龄: %.1f岁\n", stats.averageAge);
+    printf("总学生数: %d\n", stats->totalStudents);
+    printf("男学生数: %d (%.2f%%)\n", stats->maleCount,
+           (float)stats->maleCount / stats->totalStudents * 100);
+    printf("女学生数: %d (%.2f%%)\n", stats->femaleCount,
+           (float)stats->femaleCount / stats->totalStudents * 100);
+    printf("平均年龄: %.1f岁\n", stats->averageAge);
 
     printf("\n成绩统计：\n");
     printSeparator();
-    printf("最高平均分: %.2f\n", stats.highestAverage);
-    printf("最低平均分: %.2f\n", stats.lowestAverage);
-    printf("全体平均分: %.2f\n", stats.overallAverageScore);
-    printf("标准差: %.2f\n", stats.standardDeviation);
+    printf("最高平均分: %.2f\n", scoreToFloat(stats->highestAverage));
+    printf("最低平均分: %.2f\n", scoreToFloat(stats->lowestAverage));
+    printf("全体平均分: %.2f\n", stats->overallAverageScore);
+    printf("标准差: %.2f\n", stats->standardDeviation);
 
     printf("\n课程统计：\n");
     printSeparator();
-    printf("总课程数: %d\n", stats.totalCourses);
-    printf("平均课程数/人: %.1f\n", stats.averageCoursesPerStudent);
-
-    pauseSystem();
+    printf("总课程数: %d\n", stats->totalCourses);
+    printf("平均课程数/人: %.1f\n", stats->averageCoursesPerStudent);
 }
 
 /**
@@ -348,6 +451,7 @@ void displayOverallStatistics()
  *       - 成绩统计：最高/最低/平均分、标准差
  *       - 课程统计：总课程数、人均课程数
  * @note 标准差计算使用总体标准差公式
+ * @note 每项指标各自顺序扫描一列连续数组，不再跨越完整的学生记录
  */
 OverallStats calculateOverallStats()
 {
@@ -356,70 +460,45 @@ OverallStats calculateOverallStats()
     if (studentCount == 0)
         return stats;
 
+    const StudentColumns *columns = &studentColumns;
     stats.totalStudents = studentCount;
 
     float totalAge = 0;
-    float totalAverage = 0;
+    int64_t totalAverage = 0;
     int totalCourseCount = 0;
 
-    // 收集所有课程名称
-    char courses[MAX_STUDENTS * MAX_COURSES][MAX_COURSE_NAME_LENGTH];
-    int uniqueCourseCount = 0;
-
-    stats.highestAverage = students[0].averageScore;
-    stats.lowestAverage = students[0].averageScore;
-
+    // 性别统计
     for (int i = 0; i < studentCount; i++)
     {
-        // 性别统计
-        if (students[i].gender == GENDER_MALE)
-        {
-            stats.maleCount++;
-        }
-        else if (students[i].gender == GENDER_FEMALE)
-        {
-            stats.femaleCount++;
-        }
-
-        // 年龄统计
-        totalAge += students[i].age;
-
-        // 成绩统计
-        totalAverage += students[i].averageScore;
-        totalCourseCount += students[i].courseCount;
+        stats.maleCount += columns->gender[i] == GENDER_MALE;
+        stats.femaleCount += columns->gender[i] == GENDER_FEMALE;
+    }
 
-        if (students[i].averageScore > stats.highestAverage)
-        {
-            stats.highestAverage = students[i].averageScore;
-        }
-        if (students[i].averageScore < stats.lowestAverage)
-        {
-            stats.lowestAverage = students[i].averageScore;
-        }
+    // 年龄与课程数量统计
+    for (int i = 0; i < studentCount; i++)
+    {
+        totalAge += columns->age[i];
+        totalCourseCount += columns->courseCount[i];
+    }
 
-        // 课程统计
-        for (int j = 0; j < students[i].courseCount; j++)
-        {
-            bool exists = false;
-            for (int k = 0; k < uniqueCourseCount; k++)
-            {
-                if (strcmp(courses[k], students[i].courses[j]) == 0)
-                {
-                    exists = true;
-                    break;
-                }
-            }
-            if (!exists)
-            {
-                strncpy(courses[uniqueCourseCount], students[i].courses[j], MAX_COURSE_NAME_LENGTH - 1);
-                courses[uniqueCourseCount][MAX_COURSE_NAME_LENGTH - 1] = '\0';
-                uniqueCourseCount++;
-            }
-        }
+    // 成绩统计（定点整数累计，结果精确）
+    const Score *averages = columns->averageScore;
+    stats.highestAverage = averages[0];
+    stats.lowestAverage = averages[0];
+    for (int i = 0; i < studentCount; i++)
+    {
+        totalAverage += averages[i];
+        if (averages[i] > stats.highestAverage)
+            stats.highestAverage = averages[i];
+        if (averages[i] < stats.lowestAverage)
+            stats.lowestAverage = averages[i];
     }
 
+    // 课程统计
+    int uniqueCourseCount = countCoursesInUse();
+
     stats.averageAge = totalAge / studentCount;
-    stats.overallAverageScore = totalAverage / studentCount;
+    stats.overallAverageScore = (float)((double)totalAverage / studentCount / SCORE_SCALE);
     stats.totalCourses = uniqueCourseCount;
     stats.averageCoursesPerStudent = (float)totalCourseCount / studentCount;
 
@@ -427,7 +506,7 @@ OverallStats calculateOverallStats()
     float variance = 0;
     for (int i = 0; i < studentCount; i++)
     {
-        float diff = students[i].averageScore - stats.overallAverageScore;
+        float diff = scoreToFloat(averages[i]) - stats.overallAverageScore;
         variance += diff * diff;
     }
     variance /= studentCount;
@@ -531,18 +610,27 @@ void findTopScoreInCourse()
     printf("\n");
     safeInputString("请输入课程名称", courseName, MAX_COURSE_NAME_LENGTH);
 
-    float maxScore = -1;
+    if (!ensureCourseColumns())
+    {
+        printError("内存不足，无法查询课程成绩！");
+        pauseSystem();
+        return;
+    }
+
+    Score maxScore = -1;
     int maxIndex = -1;
+    int courseId = findCourseId(courseName);
+    const StudentColumns *columns = &studentColumns;
 
-    for (int i = 0; i < studentCount; i++)
+    for (int i = 0; courseId >= 0 && i < studentCount; i++)
     {
-        for (int j = 0; j < students[i].courseCount; j++)
+        for (int j = 0; j < columns->courseCount[i]; j++)
         {
-            if (strcmp(students[i].courses[j], courseName) == 0)
+            if (columns->courseIds[j][i] == courseId)
             {
-                if (students[i].scores[j] > maxScore)
+                if (columns->courseScores[j][i] > maxScore)
                 {
-                    maxScore = students[i].scores[j];
+                    maxScore = columns->courseScores[j][i];
                     maxIndex = i;
                 }
             }
@@ -558,8 +646,8 @@ void findTopScoreInCourse()
         printf("\n课程 \"%s\" 最高分：\n", courseName);
         printSeparator();
         printf("学号: %s\n", students[maxIndex].studentID);
-        printf("姓名: %s\n", students[maxIndex].name);
-        printf("分数: %.2f\n", maxScore);
+        printf("姓名: %s\n", getStudentDetail(&students[maxIndex])->name);
+        printf("分数: %.2f\n", scoreToFloat(maxScore));
     }
 
     pauseSystem();
@@ -570,15 +658,16 @@ void findTopScoreInCourse()
  * @details 计算指定学生的总分和平均分
  *          根据学生的所有课程成绩计算统计数据
  * @param student 指向要计算统计信息的学生结构体的指针
+ * @param detail 学生详细信息，提供课程成绩
  * @note 计算内容：
  *       - totalScore: 所有课程成绩的总和
  *       - averageScore: 平均成绩（总分/课程数）
  * @note 如果学生没有课程，总分和平均分都设为0
- * @warning 传入的student指针不能为NULL
+ * @warning 传入的student和detail指针不能为NULL
  */
-void calculateStudentStats(Student *student)
+void calculateStudentStats(Student *student, const StudentDetail *detail)
 {
-    if (student->courseCount == 0)
+    if (detail->courseCount == 0)
     {
         student->totalScore = 0;
         student->averageScore = 0;
@@ -586,12 +675,13 @@ void calculateStudentStats(Student *student)
     }
 
     student->totalScore = 0;
-    for (int i = 0; i < student->courseCount; i++)
+    for (int i = 0; i < detail->courseCount; i++)
     {
-        student->totalScore += student->scores[i];
+        student->totalScore += detail->scores[i];
     }
 
-    student->averageScore = student->totalScore / student->courseCount;
+    // 定点整数运算，平均分按百分之一分四舍五入
+    student->averageScore = calculateAverageScore(student->totalScore, detail->courseCount);
 }
 
 /**
@@ -605,6 +695,7 @@ void calculateStudentStats(Student *student)
  *       - statsNeedUpdate: 统计更新标志（设为false）
  * @note 如果没有学生数据，所有统计值都设为0
  * @see overallAverageScore, highestScore, lowestScore, statsNeedUpdate
+ * @note 顺序扫描平均分列完成计算
  */
 void updateGlobalStats()
 {
@@ -617,25 +708,28 @@ void updateGlobalStats()
         return;
     }
 
-    float total = 0;
-    highestScore = students[0].averageScore;
-    lowestScore = students[0].averageScore;
+    const Score *averages = studentColumns.averageScore;
+    int64_t total = 0;
+    Score highest = averages[0];
+    Score lowest = averages[0];
 
     for (int i = 0; i < studentCount; i++)
     {
-        total += students[i].averageScore;
+        total += averages[i];
 
-        if (students[i].averageScore > highestScore)
+        if (averages[i] > highest)
         {
-            highestScore = students[i].averageScore;
+            highest = averages[i];
         }
-        if (students[i].averageScore < lowestScore)
+        if (averages[i] < lowest)
         {
-            lowestScore = students[i].averageScore;
+            lowest = averages[i];
         }
     }
 
-    overallAverageScore = total / studentCount;
+    highestScore = scoreToFloat(highest);
+    lowestScore = scoreToFloat(lowest);
+    overallAverageScore = (float)((double)total / studentCount / SCORE_SCALE);
     statsNeedUpdate = false;
     
     // 使统计缓存无效
@@ -651,7 +745,7 @@ void updateGlobalStats()
  */
 // 快速排序辅助函数：分区
 int partitionRankings(StudentRank arr[], int low, int high) {
-    float pivot = arr[high].averageScore;
+    Score pivot = arr[high].averageScore;
     int i = (low - 1);
     
     for (int j = low; j <= high - 1; j++) {
@@ -685,7 +779,21 @@ void initStatisticsCache()
     statsCache.lastDataHash = 0;
     memset(&statsCache.overallStats, 0, sizeof(OverallStats));
     memset(&statsCache.scoreDistribution, 0, sizeof(ScoreDistribution));
-    memset(statsCache.rankings, 0, sizeof(statsCache.rankings));
+}
+
+/**
+ * @brief 释放统计缓存
+ * @details 释放排名缓存占用的动态内存，并将缓存标记为无效
+ * @note 在系统退出时调用
+ */
+void freeStatisticsCache()
+{
+    free(statsCache.rankings);
+    statsCache.rankings = NULL;
+    statsCache.rankingCapacity = 0;
+    free(statsCache.overallSums.courseUsage);
+    memset(&statsCache.overallSums, 0, sizeof(OverallSums));
+    statsCache.isValid = false;
 }
 
 /**
@@ -714,6 +822,131 @@ bool isCacheValid()
     return true;
 }
 
+/**
+ * @brief 调整一门课程的选课记录数
+ * @param sums 总体统计累计值
+ * @param courseId 课程编号
+ * @param delta 1表示增加一条选课记录，-1表示减少一条
+ * @return 成功返回true，计数数组扩容失败返回false
+ */
+static bool adjustCourseUsage(OverallSums *sums, CourseId courseId, int delta)
+{
+    int id = (int)courseId;
+    if (id >= sums->courseUsageCapacity)
+    {
+        int capacity = getCourseDictSize() > id ? getCourseDictSize() : id + 1;
+        int *grown = realloc(sums->courseUsage, (size_t)capacity * sizeof(int));
+        if (grown == NULL)
+            return false;
+        memset(grown + sums->courseUsageCapacity, 0,
+               (size_t)(capacity - sums->courseUsageCapacity) * sizeof(int));
+        sums->courseUsage = grown;
+        sums->courseUsageCapacity = capacity;
+    }
+
+    int before = sums->courseUsage[id];
+    sums->courseUsage[id] += delta;
+    sums->coursesInUse += (before == 0 && delta > 0) - (before + delta == 0 && before > 0);
+    return true;
+}
+
+/**
+ * @brief 把一名学生计入或移出总体统计累计值
+ * @param sums 总体统计累计值
+ * @param student 学生记录
+ * @param detail 学生详细信息
+ * @param delta 1表示计入，-1表示移出
+ * @return 成功返回true，内存不足返回false（此时累计值不再可信）
+ */
+static bool adjustOverallSums(OverallSums *sums, const Student *student, const StudentDetail *detail, int delta)
+{
+    sums->maleCount += delta * (student->gender == GENDER_MALE);
+    sums->femaleCount += delta * (student->gender == GENDER_FEMALE);
+    sums->totalAge += delta * student->age;
+    sums->totalCourseCount += delta * detail->courseCount;
+    sums->totalAverage += delta * (int64_t)student->averageScore;
+    sums->averageSquares += delta * (int64_t)student->averageScore * student->averageScore;
+
+    for (int j = 0; j < detail->courseCount; j++)
+    {
+        if (!adjustCourseUsage(sums, detail->courseIds[j], delta))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 由当前学生数据重建总体统计累计值
+ * @details 顺序扫描列式视图，选课记录按课程编号计数
+ * @param sums 总体统计累计值，计数数组保留复用
+ * @return 成功返回true，内存不足返回false
+ */
+static bool rebuildOverallSums(OverallSums *sums)
+{
+    int *usage = sums->courseUsage;
+    int capacity = sums->courseUsageCapacity;
+    memset(sums, 0, sizeof(OverallSums));
+    sums->courseUsage = usage;
+    sums->courseUsageCapacity = capacity;
+    if (usage != NULL)
+        memset(usage, 0, (size_t)capacity * sizeof(int));
+
+    if (!ensureCourseColumns())
+        return false;
+
+    const StudentColumns *columns = &studentColumns;
+    for (int i = 0; i < studentCount; i++)
+    {
+        Score average = columns->averageScore[i];
+        sums->maleCount += columns->gender[i] == GENDER_MALE;
+        sums->femaleCount += columns->gender[i] == GENDER_FEMALE;
+        sums->totalAge += columns->age[i];
+        sums->totalCourseCount += columns->courseCount[i];
+        sums->totalAverage += average;
+        sums->averageSquares += (int64_t)average * average;
+    }
+
+    for (int j = 0; j < MAX_COURSES; j++)
+    {
+        for (int i = 0; i < studentCount; i++)
+        {
+            if (j < columns->courseCount[i] && !adjustCourseUsage(sums, columns->courseIds[j][i], 1))
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 由累计值得出缓存的总体统计
+ * @details 最高和最低平均分取自排名缓存的两端，标准差由平均分的和与平方和得出
+ * @note 调用前排名缓存和累计值都已包含当前全部学生
+ */
+static void refreshCachedOverallStats()
+{
+    OverallStats stats = {0};
+    const OverallSums *sums = &statsCache.overallSums;
+    if (studentCount > 0)
+    {
+        double count = (double)studentCount;
+        stats.totalStudents = studentCount;
+        stats.maleCount = sums->maleCount;
+        stats.femaleCount = sums->femaleCount;
+        stats.averageAge = (float)(sums->totalAge / count);
+        stats.highestAverage = statsCache.rankings[0].averageScore;
+        stats.lowestAverage = statsCache.rankings[studentCount - 1].averageScore;
+        stats.overallAverageScore = (float)(sums->totalAverage / count / SCORE_SCALE);
+        stats.totalCourses = sums->coursesInUse;
+        stats.averageCoursesPerStudent = (float)(sums->totalCourseCount / count);
+
+        // 总体方差 = 平方的均值 - 均值的平方（定点单位）
+        double mean = sums->totalAverage / count;
+        double variance = sums->averageSquares / count - mean * mean;
+        stats.standardDeviation = variance > 0 ? (float)(sqrt(variance) / SCORE_SCALE) : 0;
+    }
+    statsCache.overallStats = stats;
+}
+
 /**
  * @brief 更新统计缓存
  * @details 重新计算并更新所有统计缓存数据
@@ -727,22 +960,42 @@ void updateStatisticsCache()
         return;
     }
     
-    // 更新总体统计缓存
-    statsCache.overallStats = calculateOverallStats();
+    // 总体统计的累计值，之后的增删改按差值更新
+    if (!rebuildOverallSums(&statsCache.overallSums)) {
+        statsCache.isValid = false;
+        return;
+    }
     
     // 更新分数分布缓存
     statsCache.scoreDistribution = calculateScoreDistribution();
     
-    // 更新学生排名缓存
+    // 排名缓存容量不足时按学生数组容量扩容
+    if (statsCache.rankingCapacity < studentCount) {
+        StudentRank *grown = realloc(statsCache.rankings,
+                                     (size_t)studentCapacity * sizeof(StudentRank));
+        if (grown == NULL) {
+            statsCache.isValid = false;
+            return;
+        }
+        statsCache.rankings = grown;
+        statsCache.rankingCapacity = studentCapacity;
+    }
+
+    // 更新学生排名缓存（从平均分列和总分列顺序读取）
+    const Score *averages = studentColumns.averageScore;
+    const ScoreTotal *totals = studentColumns.totalScore;
     for (int i = 0; i < studentCount; i++) {
-        statsCache.rankings[i].studentIndex = i;
-        statsCache.rankings[i].averageScore = students[i].averageScore;
-        statsCache.rankings[i].totalScore = students[i].totalScore;
+        statsCache.rankings[i].handle = students[i].handle;
+        statsCache.rankings[i].averageScore = averages[i];
+        statsCache.rankings[i].totalScore = totals[i];
     }
     
     // 使用快速排序按平均分排序（降序）
     quickSortRankings(statsCache.rankings, 0, studentCount - 1);
     
+    // 最高和最低平均分取自排好序的排名两端
+    refreshCachedOverallStats();
+    
     // 更新缓存状态
     statsCache.isValid = true;
     statsCache.lastStudentCount = studentCount;
@@ -759,39 +1012,219 @@ void invalidateCache()
     statsCache.isValid = false;
 }
 
+/**
+ * @brief 计算单条学生记录的哈希值
+ * @param student 学生记录
+ * @return unsigned long 记录的哈希值
+ * @note 基于学号、成绩等关键数据，使用DJB2算法计算
+ * @note 只读取热数据字段；课程成绩的变化会反映在总分和平均分上
+ */
+static unsigned long hashStudentRecord(const Student *student)
+{
+    unsigned long hash = 5381; // DJB2 哈希算法初始值
+
+    // 包含学号（数字学号直接使用编码键，非数字学号逐字符计算）
+    if (student->idKey != STUDENT_KEY_NON_NUMERIC) {
+        hash = ((hash << 5) + hash) + (unsigned long)student->idKey;
+    } else {
+        for (int j = 0; student->studentID[j] != '\0'; j++) {
+            hash = ((hash << 5) + hash) + student->studentID[j];
+        }
+    }
+
+    // 包含总分和平均分（定点整数，无需浮点转换）
+    hash = ((hash << 5) + hash) + (unsigned long)student->totalScore;
+    hash = ((hash << 5) + hash) + (unsigned long)student->averageScore;
+
+    // 包含年龄和性别
+    hash = ((hash << 5) + hash) + (unsigned long)student->age;
+    hash = ((hash << 5) + hash) + (unsigned char)student->gender;
+
+    return hash;
+}
+
 /**
  * @brief 计算数据哈希值
  * @details 计算当前学生数据的哈希值，用于检测数据变化
  * @return unsigned long 当前数据的哈希值
  * @note 基于学生数量、学号、成绩等关键数据计算哈希值
+ * @note 哈希值为学生数量与各记录哈希值之和，与记录顺序无关，
+ *       因此排序不会使缓存失效，增删改时也可以增量更新
  */
 unsigned long calculateDataHash()
 {
-    unsigned long hash = 5381; // DJB2 哈希算法初始值
-    
-    // 包含学生数量
-    hash = ((hash << 5) + hash) + studentCount;
-    
+    unsigned long hash = (unsigned long)studentCount;
+
     for (int i = 0; i < studentCount; i++) {
-        // 包含学号
-        for (int j = 0; students[i].studentID[j] != '\0'; j++) {
-            hash = ((hash << 5) + hash) + students[i].studentID[j];
+        hash += hashStudentRecord(&students[i]);
+    }
+
+    return hash;
+}
+
+/**
+ * @brief 调整分数分布中某个平均分所在分数段的人数
+ * @param dist 分数分布
+ * @param avgScore 平均分
+ * @param delta 人数变化量（+1或-1）
+ */
+static void adjustScoreDistribution(ScoreDistribution *dist, Score avgScore, int delta)
+{
+    if (avgScore >= 90 * SCORE_SCALE)
+        dist->excellent += delta;
+    else if (avgScore >= 80 * SCORE_SCALE)
+        dist->good += delta;
+    else if (avgScore >= 70 * SCORE_SCALE)
+        dist->medium += delta;
+    else if (avgScore >= 60 * SCORE_SCALE)
+        dist->pass += delta;
+    else
+        dist->fail += delta;
+}
+
+/**
+ * @brief 在排名缓存中插入一个学生
+ * @details 二分查找降序排列中的插入位置，后续排名整体后移
+ * @param student 要插入的学生记录
+ * @return 成功返回true，排名缓存扩容失败返回false
+ * @note 调用前studentCount已包含该学生，排名缓存中有studentCount-1条记录
+ */
+static bool insertRanking(const Student *student)
+{
+    int count = studentCount - 1;
+
+    if (statsCache.rankingCapacity < studentCount) {
+        StudentRank *grown = realloc(statsCache.rankings,
+                                     (size_t)studentCapacity * sizeof(StudentRank));
+        if (grown == NULL) {
+            return false;
         }
-        
-        // 包含总分和平均分
-        hash = ((hash << 5) + hash) + (unsigned long)(students[i].totalScore * 100);
-        hash = ((hash << 5) + hash) + (unsigned long)(students[i].averageScore * 100);
-        
-        // 包含课程数量
-        hash = ((hash << 5) + hash) + students[i].courseCount;
-        
-        // 包含各科成绩
-        for (int j = 0; j < students[i].courseCount; j++) {
-            hash = ((hash << 5) + hash) + (unsigned long)(students[i].scores[j] * 100);
+        statsCache.rankings = grown;
+        statsCache.rankingCapacity = studentCapacity;
+    }
+
+    // 查找第一个平均分低于该学生的位置
+    int low = 0, high = count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (statsCache.rankings[mid].averageScore >= student->averageScore) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
-    
-    return hash;
+
+    memmove(&statsCache.rankings[low + 1], &statsCache.rankings[low],
+            (size_t)(count - low) * sizeof(StudentRank));
+    statsCache.rankings[low].handle = student->handle;
+    statsCache.rankings[low].averageScore = student->averageScore;
+    statsCache.rankings[low].totalScore = student->totalScore;
+    return true;
+}
+
+/**
+ * @brief 从排名缓存中移除一个学生
+ * @details 二分查找平均分相同的一段排名，只在这一段中按句柄查找
+ * @param student 要移除的学生记录（平均分须与插入排名缓存时相同）
+ * @param count 移除前排名缓存中的记录数
+ * @return 找到并移除返回true，否则返回false
+ */
+static bool removeRanking(const Student *student, int count)
+{
+    // 查找第一个平均分不高于该学生的位置
+    int low = 0, high = count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (statsCache.rankings[mid].averageScore > student->averageScore) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    StudentHandle handle = student->handle;
+    for (int i = low; i < count && statsCache.rankings[i].averageScore == student->averageScore; i++) {
+        if (statsCache.rankings[i].handle.slot == handle.slot &&
+            statsCache.rankings[i].handle.generation == handle.generation) {
+            memmove(&statsCache.rankings[i], &statsCache.rankings[i + 1],
+                    (size_t)(count - i - 1) * sizeof(StudentRank));
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 缓存增量更新：新增学生
+ * @details 在排名缓存中插入新学生，并按差值更新分数分布、总体统计累计值和数据哈希值，不重新扫描全部学生
+ * @param student 新增的学生记录（已加入学生数组）
+ * @param detail 新增学生的详细信息
+ * @note 缓存无效时不做任何操作，下次访问时整体重建
+ */
+void cacheStudentAdded(const Student *student, const StudentDetail *detail)
+{
+    if (!statsCache.isValid || statsCache.lastStudentCount != studentCount - 1) {
+        statsCache.isValid = false;
+        return;
+    }
+
+    if (!insertRanking(student) || !adjustOverallSums(&statsCache.overallSums, student, detail, 1)) {
+        statsCache.isValid = false;
+        return;
+    }
+
+    adjustScoreDistribution(&statsCache.scoreDistribution, student->averageScore, 1);
+    refreshCachedOverallStats();
+    statsCache.lastStudentCount = studentCount;
+    statsCache.lastDataHash += 1 + hashStudentRecord(student);
+}
+
+/**
+ * @brief 缓存增量更新：删除学生
+ * @details 从排名缓存中移除该学生，并按差值更新分数分布、总体统计累计值和数据哈希值，不重新扫描全部学生
+ * @param removed 被删除学生记录的副本（已从学生数组中移除）
+ * @param detail 被删除学生详细信息的副本
+ * @note 缓存无效时不做任何操作，下次访问时整体重建
+ */
+void cacheStudentRemoved(const Student *removed, const StudentDetail *detail)
+{
+    if (!statsCache.isValid || statsCache.lastStudentCount != studentCount + 1 ||
+        !removeRanking(removed, studentCount + 1) ||
+        !adjustOverallSums(&statsCache.overallSums, removed, detail, -1)) {
+        statsCache.isValid = false;
+        return;
+    }
+
+    adjustScoreDistribution(&statsCache.scoreDistribution, removed->averageScore, -1);
+    refreshCachedOverallStats();
+    statsCache.lastStudentCount = studentCount;
+    statsCache.lastDataHash -= 1 + hashStudentRecord(removed);
+}
+
+/**
+ * @brief 缓存增量更新：修改学生
+ * @details 将该学生在排名缓存中重新定位，并按差值更新分数分布、总体统计累计值和数据哈希值，不重新扫描全部学生
+ * @param before 修改前学生记录的副本
+ * @param beforeDetail 修改前详细信息的副本
+ * @param after 修改后的学生记录（列式视图已同步）
+ * @param afterDetail 修改后的详细信息
+ * @note 缓存无效时不做任何操作，下次访问时整体重建
+ */
+void cacheStudentModified(const Student *before, const StudentDetail *beforeDetail,
+                          const Student *after, const StudentDetail *afterDetail)
+{
+    if (!statsCache.isValid || statsCache.lastStudentCount != studentCount ||
+        !removeRanking(before, studentCount) || !insertRanking(after) ||
+        !adjustOverallSums(&statsCache.overallSums, before, beforeDetail, -1) ||
+        !adjustOverallSums(&statsCache.overallSums, after, afterDetail, 1)) {
+        statsCache.isValid = false;
+        return;
+    }
+
+    adjustScoreDistribution(&statsCache.scoreDistribution, before->averageScore, -1);
+    adjustScoreDistribution(&statsCache.scoreDistribution, after->averageScore, 1);
+    refreshCachedOverallStats();
+    statsCache.lastDataHash += hashStudentRecord(after) - hashStudentRecord(before);
 }
 
 /**
@@ -825,19 +1258,21 @@ ScoreDistribution getCachedScoreDistribution()
 /**
  * @brief 获取缓存的学生排名
  * @details 获取缓存的学生排名数据，如果缓存无效则先更新缓存
- * @param rankings 输出参数，存储排名数据的数组
- * @return int 返回排名数据的数量
- * @note 排名按平均分降序排列，优先使用缓存数据
+ * @param rankings 输出参数，指向缓存中的排名数组（只读，缓存更新后失效）
+ * @return int 返回排名数据的数量，缓存不可用时返回0
+ * @note 排名按平均分降序排列，直接返回缓存，避免整表拷贝
  */
-int getCachedStudentRankings(StudentRank* rankings)
+int getCachedStudentRankings(const StudentRank **rankings)
 {
     if (!isCacheValid()) {
         updateStatisticsCache();
     }
     
-    if (rankings != NULL && studentCount > 0) {
-        memcpy(rankings, statsCache.rankings, studentCount * sizeof(StudentRank));
+    if (!statsCache.isValid) {
+        *rankings = NULL;
+        return 0;
     }
     
+    *rankings = statsCache.rankings;
     return studentCount;
 }
\ No newline at end of file
@@ -0,0 +1,356 @@
+/**
+ * @file stream_analysis.c
+ * @brief 流式统计分析实现
+ * @note 统计累加器只保存整数形式的和、计数与极值，各文件分别累计后合并，
+ *       最后一步才换算为OverallStats、ScoreDistribution和CourseStats
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "stream_analysis.h"
+#include "config.h"
+#include "io_utils.h"
+#include "math_utils.h"
+#include "course_dict.h"
+#include "file_utils.h"
+#include "student_io.h"
+#include "system_utils.h"
+#include "statistical_analysis.h"
+
+/**
+ * @brief 初始化统计累加器
+ * @param acc 要初始化的累加器
+ */
+void initStatsAccumulator(StatsAccumulator *acc)
+{
+    memset(acc, 0, sizeof(StatsAccumulator));
+}
+
+/**
+ * @brief 确保课程累加器数组能容纳指定编号
+ * @param acc 累加器
+ * @param courseId 课程编号
+ * @return 成功返回true，内存不足返回false
+ */
+static bool ensureCourseAccumulator(StatsAccumulator *acc, int courseId)
+{
+    if (courseId < acc->courseCapacity)
+        return true;
+
+    // 按课程字典大小扩容，字典增长时再按需扩大
+    int capacity = getCourseDictSize();
+    if (capacity <= courseId)
+        capacity = courseId + 1;
+
+    CourseAccumulator *grown = realloc(acc->courses, (size_t)capacity * sizeof(CourseAccumulator));
+    if (grown == NULL)
+        return false;
+
+    memset(grown + acc->courseCapacity, 0, (size_t)(capacity - acc->courseCapacity) * sizeof(CourseAccumulator));
+    acc->courses = grown;
+    acc->courseCapacity = capacity;
+    return true;
+}
+
+/**
+ * @brief 合并课程累加器
+ * @param into 目标课程累加器
+ * @param from 要并入的课程累加器
+ */
+static void mergeCourseAccumulator(CourseAccumulator *into, const CourseAccumulator *from)
+{
+    if (from->studentCount == 0)
+        return;
+
+    if (into->studentCount == 0 || from->maxScore > into->maxScore)
+        into->maxScore = from->maxScore;
+    if (into->studentCount == 0 || from->minScore < into->minScore)
+        into->minScore = from->minScore;
+    into->studentCount += from->studentCount;
+    into->passCount += from->passCount;
+    into->totalScore += from->totalScore;
+}
+
+/**
+ * @brief 累计一条学生记录
+ * @details 累计性别、年龄、课程数量、平均分及其平方、分数段人数和各课程成绩
+ * @param acc 累加器
+ * @param student 学生记录
+ * @param detail 学生详细信息
+ * @return 成功返回true，课程累加器扩容失败（内存不足）返回false
+ */
+bool accumulateStudent(StatsAccumulator *acc, const Student *student, const StudentDetail *detail)
+{
+    Score average = student->averageScore;
+    if (acc->studentCount == 0 || average > acc->highestAverage)
+        acc->highestAverage = average;
+    if (acc->studentCount == 0 || average < acc->lowestAverage)
+        acc->lowestAverage = average;
+
+    acc->studentCount++;
+    acc->maleCount += student->gender == GENDER_MALE;
+    acc->femaleCount += student->gender == GENDER_FEMALE;
+    acc->totalAge += student->age;
+    acc->totalCourseCount += detail->courseCount;
+    acc->totalAverage += average;
+    acc->averageSquares += (int64_t)average * average;
+    acc->atLeast[0] += average >= 90 * SCORE_SCALE;
+    acc->atLeast[1] += average >= 80 * SCORE_SCALE;
+    acc->atLeast[2] += average >= 70 * SCORE_SCALE;
+    acc->atLeast[3] += average >= 60 * SCORE_SCALE;
+
+    for (int j = 0; j < detail->courseCount && j < MAX_COURSES; j++)
+    {
+        if (!ensureCourseAccumulator(acc, detail->courseIds[j]))
+            return false;
+
+        CourseAccumulator one = {1, detail->scores[j] >= (Score)(PASS_SCORE * SCORE_SCALE),
+                                 detail->scores[j], detail->scores[j], detail->scores[j]};
+        mergeCourseAccumulator(&acc->courses[detail->courseIds[j]], &one);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 合并统计累加器
+ * @details 把from的结果并入into，结果与把两部分记录累计到同一个累加器相同
+ * @param into 目标累加器
+ * @param from 要并入的累加器（保持不变）
+ * @return 成功返回true，内存不足返回false
+ */
+bool mergeStatsAccumulator(StatsAccumulator *into, const StatsAccumulator *from)
+{
+    if (from->courseCapacity > 0 && !ensureCourseAccumulator(into, from->courseCapacity - 1))
+        return false;
+
+    if (from->studentCount > 0)
+    {
+        if (into->studentCount == 0 || from->highestAverage > into->highestAverage)
+            into->highestAverage = from->highestAverage;
+        if (into->studentCount == 0 || from->lowestAverage < into->lowestAverage)
+            into->lowestAverage = from->lowestAverage;
+    }
+
+    into->studentCount += from->studentCount;
+    into->maleCount += from->maleCount;
+    into->femaleCount += from->femaleCount;
+    into->totalAge += from->totalAge;
+    into->totalCourseCount += from->totalCourseCount;
+    into->totalAverage += from->totalAverage;
+    into->averageSquares += from->averageSquares;
+    for (int i = 0; i < 4; i++)
+    {
+        into->atLeast[i] += from->atLeast[i];
+    }
+    for (int id = 0; id < from->courseCapacity; id++)
+    {
+        mergeCourseAccumulator(&into->courses[id], &from->courses[id]);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 由累加器得出总体统计
+ * @param acc 累加器
+ * @return 与calculateOverallStats()含义相同的总体统计，没有记录时全部为0
+ * @see calculateOverallStats()
+ */
+OverallStats getAccumulatedOverallStats(const StatsAccumulator *acc)
+{
+    OverallStats stats = {0};
+    if (acc->studentCount == 0)
+        return stats;
+
+    double count = (double)acc->studentCount;
+    stats.totalStudents = (int)acc->studentCount;
+    stats.maleCount = (int)acc->maleCount;
+    stats.femaleCount = (int)acc->femaleCount;
+    stats.averageAge = (float)(acc->totalAge / count);
+    stats.highestAverage = acc->highestAverage;
+    stats.lowestAverage = acc->lowestAverage;
+    stats.overallAverageScore = (float)(acc->totalAverage / count / SCORE_SCALE);
+    stats.averageCoursesPerStudent = (float)(acc->totalCourseCount / count);
+
+    // 总体方差 = 平方的均值 - 均值的平方（定点单位），和为精确整数，不需要第二遍扫描
+    double mean = acc->totalAverage / count;
+    double variance = acc->averageSquares / count - mean * mean;
+    stats.standardDeviation = variance > 0 ? (float)(sqrt(variance) / SCORE_SCALE) : 0;
+
+    for (int id = 0; id < acc->courseCapacity; id++)
+    {
+        stats.totalCourses += acc->courses[id].studentCount > 0;
+    }
+
+    return stats;
+}
+
+/**
+ * @brief 由累加器得出分数分布
+ * @param acc 累加器
+ * @return 与calculateScoreDistribution()含义相同的分数分布
+ * @see calculateScoreDistribution()
+ */
+ScoreDistribution getAccumulatedDistribution(const StatsAccumulator *acc)
+{
+    ScoreDistribution dist;
+    dist.excellent = (int)acc->atLeast[0];
+    dist.good = (int)(acc->atLeast[1] - acc->atLeast[0]);
+    dist.medium = (int)(acc->atLeast[2] - acc->atLeast[1]);
+    dist.pass = (int)(acc->atLeast[3] - acc->atLeast[2]);
+    dist.fail = (int)(acc->studentCount - acc->atLeast[3]);
+    return dist;
+}
+
+/**
+ * @brief 由累加器得出各课程统计
+ * @param acc 累加器
+ * @param stats 输出数组，按课程编号索引
+ * @param count 数组长度，通常为getCourseDictSize()
+ * @see calculateAllCourseStats()
+ */
+void getAccumulatedCourseStats(const StatsAccumulator *acc, CourseStats *stats, int count)
+{
+    memset(stats, 0, (size_t)count * sizeof(CourseStats));
+    for (int id = 0; id < count && id < acc->courseCapacity; id++)
+    {
+        const CourseAccumulator *course = &acc->courses[id];
+        if (course->studentCount == 0)
+            continue;
+
+        stats[id].studentCount = (int)course->studentCount;
+        stats[id].maxScore = course->maxScore;
+        stats[id].minScore = course->minScore;
+        stats[id].totalScore = course->totalScore;
+        stats[id].averageScore = (float)((double)course->totalScore / course->studentCount / SCORE_SCALE);
+        stats[id].passRate = (float)((double)course->passCount / course->studentCount * 100);
+    }
+}
+
+/**
+ * @brief 释放统计累加器
+ * @param acc 累加器，释放后可重新初始化使用
+ */
+void freeStatsAccumulator(StatsAccumulator *acc)
+{
+    free(acc->courses);
+    initStatsAccumulator(acc);
+}
+
+/**
+ * @brief 流式读取时的记录处理函数
+ * @param student 学生记录
+ * @param detail 学生详细信息
+ * @param context 统计累加器
+ * @return 累计成功返回true
+ */
+static bool accumulateVisitor(const Student *student, const StudentDetail *detail, void *context)
+{
+    return accumulateStudent(context, student, detail);
+}
+
+/**
+ * @brief 流式统计单个文件
+ * @details 读取一遍文件，累计到文件自己的累加器后并入汇总累加器，并输出该文件的读取情况
+ * @param path 文件路径
+ * @param total 汇总累加器
+ * @return 成功返回true，文件无法读取或内存不足返回false
+ */
+static bool streamOneFile(const char *path, StatsAccumulator *total)
+{
+    StatsAccumulator fileStats;
+    initStatsAccumulator(&fileStats);
+    CsvErrorLog errors;
+    initCsvErrorLog(&errors);
+    int64_t rows;
+
+    // 统计不使用姓名，按列投影跳过
+    double startTime = getCurrentTimeSeconds();
+    bool ok = streamStudentsFromFile(path, accumulateVisitor, &fileStats, LOAD_COLUMNS_SCORES,
+                                     &errors, &rows);
+    double seconds = getCurrentTimeSeconds() - startTime;
+
+    if (ok)
+    {
+        // 计时精度不足时按1微秒计算，避免除零
+        if (seconds < 1e-6)
+            seconds = 1e-6;
+
+        uint64_t size = 0;
+        getFileInfo(path, &size, NULL);
+        double megabytes = (double)size / (1024.0 * 1024.0);
+        printf("%s：%lld 名学生（%lld 行，%.2f MB），耗时 %.3f 秒，%.1f MB/s\n",
+               path, (long long)fileStats.studentCount, (long long)rows, megabytes, seconds, megabytes / seconds);
+        if (errors.count > 0)
+        {
+            printf("  其中 %d 处字段格式错误、超出范围或总分平均分不符（成绩按0处理，总分平均分按各科成绩计算）\n",
+                   errors.count);
+        }
+        ok = mergeStatsAccumulator(total, &fileStats);
+    }
+
+    if (!ok)
+    {
+        printError("文件无法读取或内存不足，已跳过：");
+        printf("%s\n", path);
+    }
+
+    freeStatsAccumulator(&fileStats);
+    return ok;
+}
+
+/**
+ * @brief 显示外部文件的流式统计
+ * @details 依次输入一个或多个CSV文件路径，每个文件逐块读取一遍并累计到各自的累加器，
+ *          再合并为汇总结果，输出总体统计、分数分布和课程统计
+ * @note 文件中的记录不会加入学生列表，内存占用与文件大小无关
+ * @note 文件格式与STUDENTS_FILE相同；课程名称会登记到课程字典
+ */
+void displayStreamingStatistics()
+{
+    clearScreen();
+    printHeader("外部文件流式统计");
+    printInfo("逐块读取CSV文件并累计统计结果，记录不会加入学生列表");
+
+    int fileCount = safeInputInt("请输入文件数量", 1, MAX_STREAM_FILES);
+
+    StatsAccumulator total;
+    initStatsAccumulator(&total);
+    for (int i = 0; i < fileCount; i++)
+    {
+        char path[MAX_PATH_LENGTH];
+        char prompt[32];
+        snprintf(prompt, sizeof(prompt), "第%d个文件路径", i + 1);
+        safeInputString(prompt, path, MAX_PATH_LENGTH);
+        streamOneFile(path, &total);
+    }
+
+    if (total.studentCount == 0)
+    {
+        printWarning("暂无学生数据！");
+        freeStatsAccumulator(&total);
+        pauseSystem();
+        return;
+    }
+
+    OverallStats overall = getAccumulatedOverallStats(&total);
+    printOverallStats(&overall);
+
+    ScoreDistribution dist = getAccumulatedDistribution(&total);
+    printScoreDistribution(&dist, overall.totalStudents);
+
+    int dictSize = getCourseDictSize();
+    CourseStats *courseStats = dictSize > 0 ? malloc((size_t)dictSize * sizeof(CourseStats)) : NULL;
+    if (courseStats != NULL)
+    {
+        getAccumulatedCourseStats(&total, courseStats, dictSize);
+        printCourseStatsTable(courseStats, dictSize);
+        free(courseStats);
+    }
+
+    freeStatsAccumulator(&total);
+    pauseSystem();
+}
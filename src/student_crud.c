@@ -10,8 +10,13 @@
 #include "config.h"
 #include "globals.h"
 #include "io_utils.h"
+#include "math_utils.h"
 #include "validation.h"
 #include "statistical_analysis.h"
+#include "student_store.h"
+#include "course_dict.h"
+#include "student_id.h"
+#include "student_journal.h"
 
 /**
  * @brief 输入并验证学生学号
@@ -30,11 +35,12 @@ static void inputStudentID(Student *student)
             continue;
         }
         
-        // 检查学号是否已存在
+        // 检查学号是否已存在（比较学号编码键）
+        uint64_t key = encodeStudentID(student->studentID);
         bool exists = false;
         for (int i = 0; i < studentCount; i++)
         {
-            if (strcmp(students[i].studentID, student->studentID) == 0)
+            if (compareStudentID(students[i].idKey, students[i].studentID, key, student->studentID) == 0)
             {
                 printError("学号已存在！");
                 exists = true;
@@ -51,14 +57,15 @@ static void inputStudentID(Student *student)
  * @brief 输入并验证学生基本信息
  * @details 输入学生的姓名、年龄和性别信息
  * @param student 指向要填充的学生结构体的指针
+ * @param detail 指向要填充的学生详细信息的指针
  */
-static void inputBasicInfo(Student *student)
+static void inputBasicInfo(Student *student, StudentDetail *detail)
 {
     // 输入姓名
     while (1)
     {
-        safeInputString("请输入姓名", student->name, MAX_NAME_LENGTH);
-        if (isValidName(student->name))
+        safeInputString("请输入姓名", detail->name, MAX_NAME_LENGTH);
+        if (isValidName(detail->name))
             break;
         printError("姓名格式无效！");
     }
@@ -86,46 +93,65 @@ static void inputBasicInfo(Student *student)
     }
 }
 
+/**
+ * @brief 输入并登记课程名称
+ * @details 循环输入直到课程名称有效，并在课程字典中登记
+ * @param prompt 提示信息
+ * @return 课程编号，字典无法登记时返回-1
+ */
+static int inputCourseName(const char *prompt)
+{
+    char courseName[MAX_COURSE_NAME_LENGTH];
+
+    while (1)
+    {
+        safeInputString(prompt, courseName, MAX_COURSE_NAME_LENGTH);
+        if (isValidCourseName(courseName))
+            break;
+        printError("课程名称格式无效！课程名称不能为空。");
+    }
+
+    int courseId = internCourse(courseName);
+    if (courseId < 0)
+    {
+        printError("课程字典已满或内存不足，无法登记该课程！");
+    }
+    return courseId;
+}
+
 /**
  * @brief 输入学生课程信息
  * @details 循环输入课程名称和成绩，支持添加多门课程
- * @param student 指向要填充的学生结构体的指针
+ * @param detail 指向要填充的学生详细信息的指针
  */
-static void inputCourseInfo(Student *student)
+static void inputCourseInfo(StudentDetail *detail)
 {
     printf("\n开始输入课程信息：\n");
-    student->courseCount = 0;
+    detail->courseCount = 0;
     
-    while (student->courseCount < MAX_COURSES)
+    while (detail->courseCount < MAX_COURSES)
     {
-        printf("\n第 %d 门课程：\n", student->courseCount + 1);
+        printf("\n第 %d 门课程：\n", detail->courseCount + 1);
         
-        // 输入课程名称并验证
-        while (1)
-        {
-            safeInputString("课程名称",
-                            student->courses[student->courseCount],
-                            MAX_COURSE_NAME_LENGTH);
-            
-            if (isValidCourseName(student->courses[student->courseCount]))
-                break;
-            printError("课程名称格式无效！课程名称不能为空。");
-        }
+        // 输入课程名称并登记到课程字典
+        int courseId = inputCourseName("课程名称");
+        if (courseId < 0)
+            break;
+        detail->courseIds[detail->courseCount] = (CourseId)courseId;
         
         // 输入课程分数并验证
         while (1)
         {
-            student->scores[student->courseCount] =
-                safeInputFloat("课程分数", MIN_SCORE, MAX_SCORE);
+            detail->scores[detail->courseCount] = safeInputScore("课程分数");
             
-            if (isValidScore(student->scores[student->courseCount]))
+            if (isValidScore(detail->scores[detail->courseCount]))
                 break;
             printError("成绩输入无效！成绩必须在0-100分之间。");
         }
         
-        student->courseCount++;
+        detail->courseCount++;
         
-        if (student->courseCount < MAX_COURSES)
+        if (detail->courseCount < MAX_COURSES)
         {
             char choice = safeInputChar("\n是否继续添加课程？(y/n)");
             
@@ -141,14 +167,15 @@ static void inputCourseInfo(Student *student)
  * @brief 显示添加成功的学生信息
  * @details 显示新添加学生的基本信息和统计数据
  * @param student 指向学生结构体的指针
+ * @param detail 指向学生详细信息的指针
  */
-static void displayAddedStudentInfo(const Student *student)
+static void displayAddedStudentInfo(const Student *student, const StudentDetail *detail)
 {
     printSuccess("学生信息添加成功！");
     printf("学号: %s\n", student->studentID);
-    printf("姓名: %s\n", student->name);
-    printf("总分: %.2f\n", student->totalScore);
-    printf("平均分: %.2f\n", student->averageScore);
+    printf("姓名: %s\n", detail->name);
+    printf("总分: %.2f\n", scoreToFloat(student->totalScore));
+    printf("平均分: %.2f\n", scoreToFloat(student->averageScore));
 }
 
 /**
@@ -156,25 +183,28 @@ static void displayAddedStudentInfo(const Student *student)
  * @details 交互式地添加新学生信息，包括基本信息和课程成绩
  *          验证学号唯一性、姓名格式、年龄范围等
  *          自动计算总分和平均分
- * @note 会检查学生数量是否已达上限MAX_STUDENTS
+ * @note 学生数组按需扩容，记录数上限仅受可用内存限制
  * @note 学号必须唯一，不能与现有学生重复
- * @warning 如果学生数量已满，会显示错误信息并返回
- * @see MAX_STUDENTS, isValidStudentId(), isValidName()
+ * @note 新记录追加到变更日志，不重写CSV文件
+ * @warning 如果内存不足无法扩容，会显示错误信息并返回
+ * @see appendStudent(), isValidStudentId(), isValidName()
  */
 void addStudent()
 {
     clearScreen();
     printHeader("添加学生信息");
     
-    if (studentCount >= MAX_STUDENTS)
+    if (!ensureStudentCapacity())
     {
-        printError("学生数量已达上限！");
+        printError("内存不足，无法添加学生！");
         pauseSystem();
         return;
     }
     
     Student newStudent;
+    StudentDetail newDetail;
     memset(&newStudent, 0, sizeof(Student));
+    memset(&newDetail, 0, sizeof(StudentDetail));
     
     printf("\n");
     
@@ -182,27 +212,31 @@ void addStudent()
     inputStudentID(&newStudent);
     
     // 输入基本信息
-    inputBasicInfo(&newStudent);
+    inputBasicInfo(&newStudent, &newDetail);
     
     // 输入课程信息
-    inputCourseInfo(&newStudent);
+    inputCourseInfo(&newDetail);
     
     // 计算总分和平均分
-    calculateStudentStats(&newStudent);
+    calculateStudentStats(&newStudent, &newDetail);
     
-    // 添加到数组
-    students[studentCount] = newStudent;
-    studentCount++;
+    // 添加到数组（容量已在函数开头预留，但槽位表和详细信息页仍可能分配失败）
+    Student *added = appendStudent(&newStudent, &newDetail);
+    if (added == NULL)
+    {
+        printError("内存不足，无法添加学生！");
+        pauseSystem();
+        return;
+    }
     
-    // 标记数据已修改
-    dataModified = true;
     statsNeedUpdate = true;
     
-    // 使统计缓存无效
-    invalidateCache();
+    // 追加到变更日志，并增量更新统计缓存
+    journalStudentSaved(added);
+    cacheStudentAdded(added, getStudentDetail(added));
     
     // 显示添加成功信息
-    displayAddedStudentInfo(&newStudent);
+    displayAddedStudentInfo(&newStudent, &newDetail);
     
     pauseSystem();
 }
@@ -216,7 +250,7 @@ void addStudent()
  *       2. 查找并显示学生信息
  *       3. 用户确认删除操作
  *       4. 删除学生并重新排列数组
- *       5. 更新数据修改和统计更新标志
+ *       5. 把删除追加到变更日志，并设置统计更新标志
  * @warning 删除操作不可逆，请谨慎操作
  * @warning 如果没有学生数据，将显示警告信息
  */
@@ -235,32 +269,31 @@ void deleteStudent()
     char studentID[MAX_ID_LENGTH];
     printf("\n");
     safeInputString("请输入要删除的学生学号", studentID, MAX_ID_LENGTH);
+    uint64_t key = encodeStudentID(studentID);
 
     // 查找学生
     for (int i = 0; i < studentCount; i++)
     {
-        if (strcmp(students[i].studentID, studentID) == 0)
+        if (compareStudentID(students[i].idKey, students[i].studentID, key, studentID) == 0)
         {
             printf("\n找到学生信息：\n");
             printf("学号: %s\n", students[i].studentID);
-            printf("姓名: %s\n", students[i].name);
+            printf("姓名: %s\n", getStudentDetail(&students[i])->name);
 
             char choice = safeInputChar("\n确认删除？(y/n)");
 
             if (choice == 'y' || choice == 'Y')
             {
-                // 移动后面的学生向前
-                for (int j = i; j < studentCount - 1; j++)
-                {
-                    students[j] = students[j + 1];
-                }
-                studentCount--;
+                // 移动后面的学生向前，保留副本用于更新缓存
+                Student removed = students[i];
+                StudentDetail removedDetail = *getStudentDetail(&students[i]);
+                removeStudentAt(i);
 
-                dataModified = true;
+                journalStudentRemoved(removed.studentID);
                 statsNeedUpdate = true;
                 
-                // 使统计缓存无效
-                invalidateCache();
+                // 增量更新统计缓存
+                cacheStudentRemoved(&removed, &removedDetail);
 
                 printSuccess("学生信息删除成功！");
             }
@@ -282,12 +315,13 @@ void deleteStudent()
  * @brief 显示学生基本信息
  * @details 显示学生的学号、姓名、年龄、性别等基本信息
  * @param student 指向学生结构体的指针
+ * @param detail 指向学生详细信息的指针
  */
-static void displayStudentBasicInfo(const Student *student)
+static void displayStudentBasicInfo(const Student *student, const StudentDetail *detail)
 {
     printf("\n找到学生信息：\n");
     printf("学号: %s\n", student->studentID);
-    printf("姓名: %s\n", student->name);
+    printf("姓名: %s\n", detail->name);
     printf("年龄: %d\n", student->age);
     printf("性别: %c\n", student->gender);
 }
@@ -315,124 +349,126 @@ static void modifyStudentGender(Student *student)
 /**
  * @brief 修改现有课程成绩
  * @details 选择并修改学生的现有课程成绩
- * @param student 指向学生结构体的指针
+ * @param detail 指向学生详细信息的指针
+ * @return 修改了成绩返回true，没有课程或索引无效返回false
  */
-static void modifyExistingCourse(Student *student)
+static bool modifyExistingCourse(StudentDetail *detail)
 {
-    if (student->courseCount == 0)
+    if (detail->courseCount == 0)
     {
         printWarning("该学生没有课程记录！");
-        return;
+        return false;
     }
     
-    int courseIndex = safeInputInt("请选择要修改的课程", 1, student->courseCount) - 1;
+    int courseIndex = safeInputInt("请选择要修改的课程", 1, detail->courseCount) - 1;
     
     // 验证索引有效性
-    if (!isValidIndex(courseIndex, student->courseCount))
+    if (!isValidIndex(courseIndex, detail->courseCount))
     {
         printError("课程索引无效！");
-        return;
+        return false;
     }
     
     // 输入新成绩并验证
     while (1)
     {
-        student->scores[courseIndex] = safeInputFloat("新成绩", MIN_SCORE, MAX_SCORE);
-        if (isValidScore(student->scores[courseIndex]))
+        detail->scores[courseIndex] = safeInputScore("新成绩");
+        if (isValidScore(detail->scores[courseIndex]))
             break;
         printError("成绩输入无效！成绩必须在0-100分之间。");
     }
+    return true;
 }
 
 /**
  * @brief 添加新课程
  * @details 为学生添加新的课程和成绩
- * @param student 指向学生结构体的指针
+ * @param detail 指向学生详细信息的指针
+ * @return 添加了课程返回true，课程数量已达上限或课程无法登记返回false
  */
-static void addNewCourse(Student *student)
+static bool addNewCourse(StudentDetail *detail)
 {
-    if (student->courseCount >= MAX_COURSES)
+    if (detail->courseCount >= MAX_COURSES)
     {
         printWarning("课程数量已达上限！");
-        return;
+        return false;
     }
     
-    // 输入课程名称并验证
-    while (1)
-    {
-        safeInputString("课程名称", student->courses[student->courseCount], MAX_COURSE_NAME_LENGTH);
-        if (isValidCourseName(student->courses[student->courseCount]))
-            break;
-        printError("课程名称格式无效！课程名称不能为空。");
-    }
+    // 输入课程名称并登记到课程字典
+    int courseId = inputCourseName("课程名称");
+    if (courseId < 0)
+        return false;
+    detail->courseIds[detail->courseCount] = (CourseId)courseId;
     
     // 输入课程成绩并验证
     while (1)
     {
-        student->scores[student->courseCount] = safeInputFloat("课程成绩", MIN_SCORE, MAX_SCORE);
-        if (isValidScore(student->scores[student->courseCount]))
+        detail->scores[detail->courseCount] = safeInputScore("课程成绩");
+        if (isValidScore(detail->scores[detail->courseCount]))
             break;
         printError("成绩输入无效！成绩必须在0-100分之间。");
     }
     
-    student->courseCount++;
+    detail->courseCount++;
+    return true;
 }
 
 /**
  * @brief 删除课程
  * @details 删除学生的指定课程和成绩
- * @param student 指向学生结构体的指针
+ * @param detail 指向学生详细信息的指针
+ * @return 删除了课程返回true，没有课程或索引无效返回false
  */
-static void deleteCourse(Student *student)
+static bool deleteCourse(StudentDetail *detail)
 {
-    if (student->courseCount == 0)
+    if (detail->courseCount == 0)
     {
         printWarning("该学生没有课程记录！");
-        return;
+        return false;
     }
     
-    int courseIndex = safeInputInt("请选择要删除的课程", 1, student->courseCount) - 1;
+    int courseIndex = safeInputInt("请选择要删除的课程", 1, detail->courseCount) - 1;
     
     // 验证索引有效性
-    if (!isValidIndex(courseIndex, student->courseCount))
+    if (!isValidIndex(courseIndex, detail->courseCount))
     {
         printError("课程索引无效！");
-        return;
+        return false;
     }
     
     // 移动数组元素
-    for (int k = courseIndex; k < student->courseCount - 1; k++)
+    for (int k = courseIndex; k < detail->courseCount - 1; k++)
     {
-        strncpy(student->courses[k], student->courses[k + 1], MAX_COURSE_NAME_LENGTH - 1);
-        student->courses[k][MAX_COURSE_NAME_LENGTH - 1] = '\0';
-        student->scores[k] = student->scores[k + 1];
+        detail->courseIds[k] = detail->courseIds[k + 1];
+        detail->scores[k] = detail->scores[k + 1];
     }
-    student->courseCount--;
+    detail->courseCount--;
+    return true;
 }
 
 /**
  * @brief 显示课程列表
  * @details 显示学生的所有课程和成绩
- * @param student 指向学生结构体的指针
+ * @param detail 指向学生详细信息的指针
  */
-static void displayCourseList(const Student *student)
+static void displayCourseList(const StudentDetail *detail)
 {
     printf("\n当前课程列表：\n");
-    for (int j = 0; j < student->courseCount; j++)
+    for (int j = 0; j < detail->courseCount; j++)
     {
-        printf("%d. %s: %.2f\n", j + 1, student->courses[j], student->scores[j]);
+        printf("%d. %s: %.2f\n", j + 1, getCourseName(detail->courseIds[j]), scoreToFloat(detail->scores[j]));
     }
 }
 
 /**
  * @brief 修改课程信息
  * @details 提供课程修改的子菜单，包括修改、添加、删除课程
- * @param student 指向学生结构体的指针
+ * @param detail 指向学生详细信息的指针
  * @return true 如果进行了课程修改，false 如果没有修改
  */
-static bool modifyCourseInfo(Student *student)
+static bool modifyCourseInfo(StudentDetail *detail)
 {
-    displayCourseList(student);
+    displayCourseList(detail);
     
     printf("\n修改选项：\n");
     printf("1. 修改现有课程成绩\n");
@@ -444,14 +480,11 @@ static bool modifyCourseInfo(Student *student)
     switch (courseChoice)
     {
     case 1: // 修改现有课程成绩
-        modifyExistingCourse(student);
-        return true;
+        return modifyExistingCourse(detail);
     case 2: // 添加新课程
-        addNewCourse(student);
-        return true;
+        return addNewCourse(detail);
     case 3: // 删除课程
-        deleteCourse(student);
-        return true;
+        return deleteCourse(detail);
     case 0:
         return false;
     }
@@ -461,11 +494,12 @@ static bool modifyCourseInfo(Student *student)
 /**
  * @brief 处理学生信息修改
  * @details 处理找到学生后的修改操作
- * @param student 指向学生结构体的指针
+ * @param student 指向学生结构体的指针（学生数组中的记录）
  */
 static void handleStudentModification(Student *student)
 {
-    displayStudentBasicInfo(student);
+    StudentDetail *detail = getStudentDetail(student);
+    displayStudentBasicInfo(student, detail);
     
     printf("\n修改选项：\n");
     printf("1. 修改姓名\n");
@@ -481,7 +515,7 @@ static void handleStudentModification(Student *student)
     switch (choice)
     {
     case 1: // 修改姓名
-        safeInputString("请输入新姓名", student->name, MAX_NAME_LENGTH);
+        safeInputString("请输入新姓名", detail->name, MAX_NAME_LENGTH);
         break;
     case 2: // 修改年龄
         student->age = safeInputInt("请输入新年龄", 10, 100);
@@ -490,7 +524,9 @@ static void handleStudentModification(Student *student)
         modifyStudentGender(student);
         break;
     case 4: // 修改课程成绩
-        courseModified = modifyCourseInfo(student);
+        courseModified = modifyCourseInfo(detail);
+        if (!courseModified)
+            return; // 返回、没有课程或课程无法登记时记录未变，无需写入日志
         break;
     case 0:
         return;
@@ -498,15 +534,12 @@ static void handleStudentModification(Student *student)
     
     if (courseModified)
     {
-        calculateStudentStats(student);
+        calculateStudentStats(student, detail);
     }
     
-    dataModified = true;
+    journalStudentSaved(student);
     statsNeedUpdate = true;
     
-    // 使统计缓存无效
-    invalidateCache();
-    
     printSuccess("学生信息修改成功！");
 }
 
@@ -523,6 +556,7 @@ static void handleStudentModification(Student *student)
  *       - 修改现有课程成绩
  *       - 添加新课程
  *       - 删除课程
+ * @note 修改后的完整记录追加到变更日志，不重写CSV文件
  * @warning 修改课程信息后会自动重新计算总分和平均分
  */
 void modifyStudent()
@@ -540,13 +574,18 @@ void modifyStudent()
     char studentID[MAX_ID_LENGTH];
     printf("\n");
     safeInputString("请输入要修改的学生学号", studentID, MAX_ID_LENGTH);
+    uint64_t key = encodeStudentID(studentID);
     
     // 查找学生
     for (int i = 0; i < studentCount; i++)
     {
-        if (strcmp(students[i].studentID, studentID) == 0)
+        if (compareStudentID(students[i].idKey, students[i].studentID, key, studentID) == 0)
         {
+            Student before = students[i];
+            StudentDetail beforeDetail = *getStudentDetail(&students[i]);
             handleStudentModification(&students[i]);
+            syncStudentColumns(i);
+            cacheStudentModified(&before, &beforeDetail, &students[i], getStudentDetail(&students[i]));
             pauseSystem();
             return;
         }
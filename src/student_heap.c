@@ -0,0 +1,775 @@
+/**
+ * @file student_heap.c
+ * @brief 学生数据二进制快照实现
+ * @note 按列存放的二进制快照：年龄、性别、成绩、总分、平均分为定宽列，
+ *       学号、姓名和课程名称集中存放在字符串表中
+ *       启动时映射文件、校验后按列恢复，不再逐行解析CSV
+ *       CSV文件仍是人工编辑和导入导出的格式，CSV被外部修改后以CSV为准重新导入
+ *       学生数据按行分块计算CRC32C，启动时并行校验，损坏的块只重新解析CSV中对应的区间
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+#include "student_heap.h"
+#include "config.h"
+#include "globals.h"
+#include "io_utils.h"
+#include "file_utils.h"
+#include "system_utils.h"
+#include "student_store.h"
+#include "student_io.h"
+#include "course_dict.h"
+#include "crc32c.h"
+#include "statistical_analysis.h"
+
+_Static_assert(sizeof(StudentHeapHeader) % 8 == 0, "StudentHeapHeader must keep 8-byte alignment");
+_Static_assert(MAX_COURSES <= UINT8_MAX, "course counts are stored as uint8_t");
+
+/**
+ * @brief 映射后的快照列视图
+ * @details 各列指针由映射基址加上文件头中的数据块偏移得到
+ */
+typedef struct {
+    const int32_t *ages;
+    const char *genders;
+    const uint8_t *courseCounts;
+    const CourseId *courseIds;
+    const Score *scores;
+    const ScoreTotal *totals;
+    const Score *averages;
+    const uint32_t *idRefs;
+    const uint32_t *nameRefs;
+    const uint32_t *courseNameRefs;
+    const StudentHeapBlock *blocks;
+    const char *strings;
+    uint64_t stringTableSize;
+    int studentCount;
+    int blockRows;
+    int blockCount;
+} StudentHeapView;
+
+/**
+ * @brief 并行校验的工作队列
+ * @note 各线程通过原子计数器依次领取校验块
+ */
+typedef struct {
+    const StudentHeapView *view;    // 列视图
+    bool *damaged;                  // 输出：各块是否校验失败
+    atomic_int nextBlock;           // 下一个待领取的块下标
+} HeapVerifyPool;
+
+/**
+ * @brief 向上对齐到8字节
+ * @param value 偏移或大小
+ * @return 对齐后的值
+ */
+static uint64_t alignTo8(uint64_t value)
+{
+    return (value + 7) & ~(uint64_t)7;
+}
+
+/**
+ * @brief 计算校验块数
+ * @param studentCount 学生数量
+ * @param blockRows 每块行数
+ * @return 校验块数，最后一块可以不满
+ */
+static int heapBlockCount(int studentCount, int blockRows)
+{
+    return (int)(((int64_t)studentCount + blockRows - 1) / blockRows);
+}
+
+/**
+ * @brief 计算数据块大小
+ * @param section 数据块编号
+ * @param header 文件头，提供学生数量、课程数量、校验块行数和字符串表字节数
+ * @return 数据块字节数（不含对齐填充）
+ */
+static uint64_t heapSectionSize(int section, const StudentHeapHeader *header)
+{
+    uint64_t studentCount = (uint64_t)header->studentCount;
+    uint64_t courseCount = (uint64_t)header->courseCount;
+    switch (section)
+    {
+    case HEAP_SECTION_AGES:
+        return studentCount * sizeof(int32_t);
+    case HEAP_SECTION_GENDERS:
+        return studentCount * sizeof(char);
+    case HEAP_SECTION_COURSE_COUNTS:
+        return studentCount * sizeof(uint8_t);
+    case HEAP_SECTION_COURSE_IDS:
+        return studentCount * MAX_COURSES * sizeof(CourseId);
+    case HEAP_SECTION_SCORES:
+        return studentCount * MAX_COURSES * sizeof(Score);
+    case HEAP_SECTION_TOTALS:
+        return studentCount * sizeof(ScoreTotal);
+    case HEAP_SECTION_AVERAGES:
+        return studentCount * sizeof(Score);
+    case HEAP_SECTION_ID_REFS:
+    case HEAP_SECTION_NAME_REFS:
+        return studentCount * sizeof(uint32_t);
+    case HEAP_SECTION_COURSE_NAME_REFS:
+        return courseCount * sizeof(uint32_t);
+    case HEAP_SECTION_BLOCKS:
+        return (uint64_t)heapBlockCount(header->studentCount, (int)header->blockRows) * sizeof(StudentHeapBlock);
+    default:
+        return header->stringTableSize;
+    }
+}
+
+/**
+ * @brief 按顺序排布各数据块
+ * @param header 文件头，读取其中的数量字段，填写sectionOffsets
+ * @return 文件总字节数
+ */
+static uint64_t layoutHeapSections(StudentHeapHeader *header)
+{
+    uint64_t offset = alignTo8(sizeof(StudentHeapHeader));
+    for (int section = 0; section < HEAP_SECTION_COUNT; section++)
+    {
+        header->sectionOffsets[section] = offset;
+        offset = alignTo8(offset + heapSectionSize(section, header));
+    }
+    return offset;
+}
+
+/**
+ * @brief 校验快照文件头
+ * @param header 文件头
+ * @param fileSize 快照文件大小
+ * @return 文件头有效且各数据块都在文件范围内时返回true
+ */
+static bool validateHeapHeader(const StudentHeapHeader *header, size_t fileSize)
+{
+    if (memcmp(header->magic, STUDENT_HEAP_MAGIC, sizeof(STUDENT_HEAP_MAGIC)) != 0 ||
+        header->version != STUDENT_HEAP_VERSION ||
+        header->headerSize != sizeof(StudentHeapHeader) ||
+        header->maxCourses != MAX_COURSES ||
+        header->blockRows == 0 || header->blockRows > INT32_MAX ||
+        header->studentCount < 0 || header->courseCount < 0 ||
+        header->courseCount > MAX_COURSE_DICT_SIZE ||
+        header->stringTableSize > fileSize)
+    {
+        return false;
+    }
+
+    // 偏移必须与按数量重新排布的结果一致，这样每一列都对齐且不会越过文件末尾
+    StudentHeapHeader expected = *header;
+    return layoutHeapSections(&expected) == fileSize &&
+           header->payloadSize == fileSize - sizeof(StudentHeapHeader) &&
+           memcmp(expected.sectionOffsets, header->sectionOffsets, sizeof(header->sectionOffsets)) == 0;
+}
+
+/**
+ * @brief 建立快照的列视图
+ * @details 各列地址 = 文件起始地址 + 数据块偏移，保存和恢复共用
+ * @param view 输出参数，列视图
+ * @param data 快照文件内容（映射的文件或内存中组装的映像）
+ * @param header 文件头
+ */
+static void mapHeapView(StudentHeapView *view, const unsigned char *data, const StudentHeapHeader *header)
+{
+    const uint64_t *offsets = header->sectionOffsets;
+    view->ages = (const int32_t *)(data + offsets[HEAP_SECTION_AGES]);
+    view->genders = (const char *)(data + offsets[HEAP_SECTION_GENDERS]);
+    view->courseCounts = data + offsets[HEAP_SECTION_COURSE_COUNTS];
+    view->courseIds = (const CourseId *)(data + offsets[HEAP_SECTION_COURSE_IDS]);
+    view->scores = (const Score *)(data + offsets[HEAP_SECTION_SCORES]);
+    view->totals = (const ScoreTotal *)(data + offsets[HEAP_SECTION_TOTALS]);
+    view->averages = (const Score *)(data + offsets[HEAP_SECTION_AVERAGES]);
+    view->idRefs = (const uint32_t *)(data + offsets[HEAP_SECTION_ID_REFS]);
+    view->nameRefs = (const uint32_t *)(data + offsets[HEAP_SECTION_NAME_REFS]);
+    view->courseNameRefs = (const uint32_t *)(data + offsets[HEAP_SECTION_COURSE_NAME_REFS]);
+    view->blocks = (const StudentHeapBlock *)(data + offsets[HEAP_SECTION_BLOCKS]);
+    view->strings = (const char *)(data + offsets[HEAP_SECTION_STRINGS]);
+    view->stringTableSize = header->stringTableSize;
+    view->studentCount = header->studentCount;
+    view->blockRows = (int)header->blockRows;
+    view->blockCount = heapBlockCount(header->studentCount, (int)header->blockRows);
+}
+
+/**
+ * @brief 获取校验块的行数
+ * @param view 列视图
+ * @param block 块下标
+ * @return 块内学生数，只有最后一块可能不满
+ */
+static int heapBlockLength(const StudentHeapView *view, int block)
+{
+    int first = block * view->blockRows;
+    int remaining = view->studentCount - first;
+    return remaining < view->blockRows ? remaining : view->blockRows;
+}
+
+/**
+ * @brief 计算校验块的CRC32C
+ * @details 依次覆盖块内各行在每一列中的切片，以及这些行的学号和姓名字符串
+ * @param view 列视图
+ * @param block 块下标
+ * @return 块的校验和
+ */
+static uint32_t computeHeapBlockChecksum(const StudentHeapView *view, int block)
+{
+    size_t first = (size_t)block * (size_t)view->blockRows;
+    size_t count = (size_t)heapBlockLength(view, block);
+    const StudentHeapBlock *entry = &view->blocks[block];
+
+    uint32_t crc = 0;
+    crc = crc32c(crc, view->ages + first, count * sizeof(int32_t));
+    crc = crc32c(crc, view->genders + first, count * sizeof(char));
+    crc = crc32c(crc, view->courseCounts + first, count * sizeof(uint8_t));
+    crc = crc32c(crc, view->courseIds + first * MAX_COURSES, count * MAX_COURSES * sizeof(CourseId));
+    crc = crc32c(crc, view->scores + first * MAX_COURSES, count * MAX_COURSES * sizeof(Score));
+    crc = crc32c(crc, view->totals + first, count * sizeof(ScoreTotal));
+    crc = crc32c(crc, view->averages + first, count * sizeof(Score));
+    crc = crc32c(crc, view->idRefs + first, count * sizeof(uint32_t));
+    crc = crc32c(crc, view->nameRefs + first, count * sizeof(uint32_t));
+    crc = crc32c(crc, view->strings + entry->stringOffset, (size_t)entry->stringSize);
+    return crc;
+}
+
+/**
+ * @brief 计算文件头、课程名称和校验块表的CRC32C
+ * @details 文件头按checksum字段为0计算；课程名称字符串位于字符串表中各行字符串之后
+ * @param header 文件头
+ * @param view 列视图
+ * @param rowStringsEnd 各行字符串的结束偏移，即课程名称字符串的起始偏移
+ * @return 校验和
+ */
+static uint32_t computeHeapMetadataChecksum(const StudentHeapHeader *header, const StudentHeapView *view,
+                                            uint64_t rowStringsEnd)
+{
+    StudentHeapHeader copy = *header;
+    copy.checksum = 0;
+
+    uint32_t crc = crc32c(0, &copy, sizeof(copy));
+    crc = crc32c(crc, view->courseNameRefs, (size_t)header->courseCount * sizeof(uint32_t));
+    crc = crc32c(crc, view->blocks, (size_t)view->blockCount * sizeof(StudentHeapBlock));
+    crc = crc32c(crc, view->strings + rowStringsEnd, (size_t)(view->stringTableSize - rowStringsEnd));
+    return crc;
+}
+
+/**
+ * @brief 校验校验块表
+ * @details 各块的字符串区间必须从0开始首尾相接，并且都在字符串表内
+ * @param view 列视图
+ * @param rowStringsEnd 输出参数，各行字符串的结束偏移
+ * @return 块表一致返回true
+ */
+static bool validateHeapBlocks(const StudentHeapView *view, uint64_t *rowStringsEnd)
+{
+    uint64_t offset = 0;
+    for (int block = 0; block < view->blockCount; block++)
+    {
+        const StudentHeapBlock *entry = &view->blocks[block];
+        if (entry->stringOffset != offset || entry->stringSize > view->stringTableSize - offset)
+            return false;
+        offset += entry->stringSize;
+    }
+    *rowStringsEnd = offset;
+    return true;
+}
+
+/**
+ * @brief 校验线程入口
+ * @details 从工作队列中依次领取校验块，重新计算CRC32C并与块表比较
+ * @param arg 工作队列（HeapVerifyPool）
+ * @return 总是返回NULL
+ */
+static void *verifyHeapWorker(void *arg)
+{
+    HeapVerifyPool *pool = arg;
+    const StudentHeapView *view = pool->view;
+    int block;
+    while ((block = atomic_fetch_add(&pool->nextBlock, 1)) < view->blockCount)
+    {
+        pool->damaged[block] = computeHeapBlockChecksum(view, block) != view->blocks[block].checksum;
+    }
+    return NULL;
+}
+
+/**
+ * @brief 并行校验全部校验块
+ * @details 线程数与CSV加载相同：--threads=N指定时使用N个线程，否则按CPU核数选择；
+ *          快照小于PARALLEL_LOAD_MIN_BYTES时在当前线程校验
+ * @param view 列视图
+ * @param fileSize 快照文件大小
+ * @param damaged 输出参数，各块是否校验失败
+ * @return 校验失败的块数
+ */
+static int verifyHeapBlocks(const StudentHeapView *view, size_t fileSize, bool *damaged)
+{
+    HeapVerifyPool pool;
+    pool.view = view;
+    pool.damaged = damaged;
+    atomic_init(&pool.nextBlock, 0);
+
+#ifndef _WIN32
+    int threadCount = 1;
+    if (runtimeOptions.loadThreads > 0)
+        threadCount = runtimeOptions.loadThreads;
+    else if (fileSize >= PARALLEL_LOAD_MIN_BYTES)
+        threadCount = getProcessorCount() < MAX_LOAD_THREADS ? getProcessorCount() : MAX_LOAD_THREADS;
+    if (threadCount > view->blockCount)
+        threadCount = view->blockCount;
+
+    // 线程创建失败时由其余线程（至少有当前线程）完成剩余的块
+    pthread_t threads[MAX_LOAD_THREADS];
+    int started = 0;
+    for (int i = 1; i < threadCount; i++)
+    {
+        if (pthread_create(&threads[started], NULL, verifyHeapWorker, &pool) == 0)
+            started++;
+    }
+#else
+    (void)fileSize;
+#endif
+
+    verifyHeapWorker(&pool);
+
+#ifndef _WIN32
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+#endif
+
+    int damagedCount = 0;
+    for (int block = 0; block < view->blockCount; block++)
+    {
+        damagedCount += damaged[block];
+    }
+    return damagedCount;
+}
+
+/**
+ * @brief 检查快照是否已过期
+ * @param header 文件头
+ * @return CSV文件在快照生成后被修改过（例如手工编辑或外部导入）返回true；CSV文件不存在时返回false
+ */
+static bool isHeapStale(const StudentHeapHeader *header)
+{
+    uint64_t sourceSize;
+    int64_t sourceModifiedTime;
+    return getFileInfo(STUDENTS_FILE, &sourceSize, &sourceModifiedTime) &&
+           (sourceSize != header->sourceSize || sourceModifiedTime != header->sourceModifiedTime);
+}
+
+/**
+ * @brief 从字符串表复制字符串
+ * @param view 列视图
+ * @param offset 字符串在表中的偏移
+ * @param dest 目标缓冲区
+ * @param destSize 目标缓冲区大小，超长部分截断
+ * @return 偏移有效且字符串在表内结束时返回true
+ */
+static bool copyHeapString(const StudentHeapView *view, uint32_t offset, char *dest, size_t destSize)
+{
+    if (offset >= view->stringTableSize)
+        return false;
+
+    const char *text = view->strings + offset;
+    if (memchr(text, '\0', (size_t)(view->stringTableSize - offset)) == NULL)
+        return false;
+
+    strncpy(dest, text, destSize - 1);
+    dest[destSize - 1] = '\0';
+    return true;
+}
+
+/**
+ * @brief 按编号顺序恢复课程字典
+ * @param view 列视图
+ * @param courseCount 课程数量
+ * @return 成功返回true；数据不一致或内存不足返回false
+ * @note 空字典中分配的编号与快照中的编号一致
+ */
+static bool restoreHeapCourses(const StudentHeapView *view, int courseCount)
+{
+    char courseName[MAX_COURSE_NAME_LENGTH];
+    for (int id = 0; id < courseCount; id++)
+    {
+        if (!copyHeapString(view, view->courseNameRefs[id], courseName, sizeof(courseName)) ||
+            internCourse(courseName) != id)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 按列恢复一段学生记录
+ * @param view 列视图
+ * @param first 第一行的下标
+ * @param count 行数
+ * @param courseCount 课程数量，用于检查课程编号
+ * @return 成功返回true；数据不一致或内存不足返回false
+ */
+static bool restoreHeapRows(const StudentHeapView *view, int first, int count, int courseCount)
+{
+    for (int i = first; i < first + count; i++)
+    {
+        Student student;
+        StudentDetail detail;
+        memset(&student, 0, sizeof(student));
+        memset(&detail, 0, sizeof(detail));
+
+        if (!copyHeapString(view, view->idRefs[i], student.studentID, MAX_ID_LENGTH) ||
+            !copyHeapString(view, view->nameRefs[i], detail.name, MAX_NAME_LENGTH) ||
+            view->courseCounts[i] > MAX_COURSES)
+        {
+            return false;
+        }
+
+        student.age = view->ages[i];
+        student.gender = view->genders[i];
+        student.totalScore = view->totals[i];
+        student.averageScore = view->averages[i];
+        detail.courseCount = view->courseCounts[i];
+
+        const CourseId *courseIds = view->courseIds + (size_t)i * MAX_COURSES;
+        const Score *scores = view->scores + (size_t)i * MAX_COURSES;
+        for (int j = 0; j < MAX_COURSES; j++)
+        {
+            if (j < detail.courseCount && courseIds[j] >= courseCount)
+                return false;
+            detail.courseIds[j] = courseIds[j];
+            detail.scores[j] = scores[j];
+        }
+
+        if (appendStudent(&student, &detail) == NULL)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 从CSV文件重新解析一个损坏的校验块
+ * @param view 列视图
+ * @param block 块下标
+ * @param source 映射的CSV文件
+ * @param sourceSize CSV文件字节数
+ * @return 重新解析出的行数与块的行数相同时返回true；位置未知或结果不符时返回false
+ */
+static bool reparseHeapBlock(const StudentHeapView *view, int block, const char *source, size_t sourceSize)
+{
+    const StudentHeapBlock *entry = &view->blocks[block];
+    if (source == NULL || entry->sourceSize == 0 || entry->sourceOffset > sourceSize ||
+        entry->sourceSize > sourceSize - entry->sourceOffset)
+    {
+        return false;
+    }
+
+    const char *start = source + entry->sourceOffset;
+    return loadStudentsFromRange(start, start + entry->sourceSize) == heapBlockLength(view, block);
+}
+
+/**
+ * @brief 按块恢复学生记录
+ * @details 校验通过的块按列恢复，损坏的块从CSV文件中对应的区间重新解析，记录顺序与快照相同
+ * @param view 列视图
+ * @param courseCount 课程数量
+ * @param damaged 各块是否校验失败
+ * @param damagedCount 校验失败的块数
+ * @return 成功返回true；数据不一致、CSV无法读取或内存不足返回false
+ */
+static bool restoreHeapBlocks(const StudentHeapView *view, int courseCount, const bool *damaged, int damagedCount)
+{
+    if (!restoreHeapCourses(view, courseCount) || !reserveStudents(view->studentCount))
+        return false;
+
+    size_t sourceSize = 0;
+    const char *source = damagedCount > 0 ? mapFile(STUDENTS_FILE, &sourceSize) : NULL;
+
+    bool ok = true;
+    for (int block = 0; ok && block < view->blockCount; block++)
+    {
+        if (damaged[block])
+            ok = reparseHeapBlock(view, block, source, sourceSize);
+        else
+            ok = restoreHeapRows(view, block * view->blockRows, heapBlockLength(view, block), courseCount);
+    }
+
+    unmapFile(source, sourceSize);
+    return ok;
+}
+
+/**
+ * @brief 从二进制快照恢复学生数据
+ * @details 映射STUDENTS_HEAP_FILE，校验文件头、版本和校验和，
+ *          并确认CSV文件在快照生成后没有被修改，然后按列把记录装入学生存储和课程字典
+ *          各校验块的CRC32C由多个线程并行校验，损坏的块从CSV文件中对应的区间重新解析，其余块照常按列恢复
+ * @return 恢复成功返回true；快照不存在、已过期或校验失败时返回false，学生存储保持为空
+ * @note 返回false时调用者应回退到loadStudentsFromFile()
+ * @note 有块被重新解析时会重写快照
+ * @warning 必须在学生存储和课程字典为空时调用
+ */
+bool loadStudentHeap()
+{
+    size_t fileSize;
+    const unsigned char *data = mapFile(STUDENTS_HEAP_FILE, &fileSize);
+    if (data == NULL)
+        return false;
+
+    // 文件头、课程名称和块表损坏时无法定位各块，只能整体重新导入
+    initCrc32c();
+    const StudentHeapHeader *header = (const StudentHeapHeader *)data;
+    StudentHeapView view;
+    uint64_t rowStringsEnd = 0;
+    bool valid = fileSize >= sizeof(StudentHeapHeader) && validateHeapHeader(header, fileSize);
+    if (valid)
+    {
+        mapHeapView(&view, data, header);
+        valid = validateHeapBlocks(&view, &rowStringsEnd) &&
+                computeHeapMetadataChecksum(header, &view, rowStringsEnd) == header->checksum;
+    }
+    if (!valid)
+    {
+        printWarning("学生数据快照已损坏或版本不符，将从CSV文件重新导入");
+        unmapFile(data, fileSize);
+        return false;
+    }
+
+    if (isHeapStale(header))
+    {
+        printInfo("CSV文件在快照生成后被修改过，将从CSV文件重新导入");
+        unmapFile(data, fileSize);
+        return false;
+    }
+
+    bool *damaged = calloc((size_t)(view.blockCount > 0 ? view.blockCount : 1), sizeof(bool));
+    if (damaged == NULL)
+    {
+        unmapFile(data, fileSize);
+        return false;
+    }
+
+    int damagedCount = verifyHeapBlocks(&view, fileSize, damaged);
+    bool ok = restoreHeapBlocks(&view, header->courseCount, damaged, damagedCount);
+    int blockCount = view.blockCount;
+    int blockRows = view.blockRows;
+    free(damaged);
+    unmapFile(data, fileSize);
+
+    if (!ok)
+    {
+        // 恢复到一半失败时清空，避免与CSV回退加载的数据混在一起
+        printWarning("学生数据快照内容不一致，将从CSV文件重新导入");
+        freeStudentStore();
+        freeCourseDict();
+        return false;
+    }
+
+    if (damagedCount > 0)
+    {
+        printWarning("学生数据快照部分数据块校验失败，已从CSV文件重新解析这些数据块");
+        fprintf(messageStream(), "  损坏的数据块：%d / %d（每块 %d 行）\n", damagedCount, blockCount, blockRows);
+        if (!saveStudentHeap())
+        {
+            printWarning("无法重写二进制快照，下次启动将再次重新解析损坏的数据块");
+        }
+    }
+
+    statsNeedUpdate = true;
+    invalidateCache();
+    return true;
+}
+
+/**
+ * @brief 向字符串表追加字符串
+ * @param table 字符串表
+ * @param used 已使用的字节数，返回时更新
+ * @param text 要追加的字符串
+ * @return 字符串在表中的偏移
+ */
+static uint32_t appendHeapString(char *table, uint64_t *used, const char *text)
+{
+    uint32_t offset = (uint32_t)*used;
+    size_t length = strlen(text) + 1;
+    memcpy(table + *used, text, length);
+    *used += length;
+    return offset;
+}
+
+/**
+ * @brief 找出各校验块在CSV文件中的字节区间
+ * @details 跳过头部后逐行比较行首的学号与学生数组中的下一条记录，学号相同即为该记录所在的行；
+ *          不匹配的行（首次导入时被跳过的问题行）归入前一块的区间，重新解析时同样会被跳过
+ * @param blocks 校验块表，填写sourceOffset和sourceSize
+ * @param blockCount 校验块数
+ * @return 全部记录都找到对应的行时返回true；CSV文件无法读取或记录顺序与文件不一致时返回false，
+ *         此时各块的位置记为未知
+ */
+static bool locateHeapSources(StudentHeapBlock *blocks, int blockCount)
+{
+    size_t size = 0;
+    const char *data = studentCount > 0 ? mapFile(STUDENTS_FILE, &size) : NULL;
+    int matched = 0;
+    const char *end = data;
+    const char *line = data;
+    if (data != NULL)
+    {
+        end = data + size;
+        line = memchr(data, '\n', size);
+        line = line != NULL ? line + 1 : end;
+    }
+
+    while (line < end && matched < studentCount)
+    {
+        const char *newline = memchr(line, '\n', (size_t)(end - line));
+        const char *nextLine = newline != NULL ? newline + 1 : end;
+        const char *comma = memchr(line, ',', (size_t)(nextLine - line));
+
+        // 加载时学号超长的部分被截断，这里按截断后的内容比较
+        size_t length = comma != NULL ? (size_t)(comma - line) : 0;
+        if (length > MAX_ID_LENGTH - 1)
+            length = MAX_ID_LENGTH - 1;
+        const char *id = students[matched].studentID;
+        if (comma != NULL && strlen(id) == length && memcmp(id, line, length) == 0)
+        {
+            if (matched % HEAP_BLOCK_ROWS == 0)
+                blocks[matched / HEAP_BLOCK_ROWS].sourceOffset = (uint64_t)(line - data);
+            matched++;
+        }
+        line = nextLine;
+    }
+
+    bool ok = data != NULL && matched == studentCount;
+    for (int block = 0; block < blockCount; block++)
+    {
+        uint64_t stop = block + 1 < blockCount ? blocks[block + 1].sourceOffset : (uint64_t)size;
+        blocks[block].sourceSize = ok ? stop - blocks[block].sourceOffset : 0;
+        if (!ok)
+            blocks[block].sourceOffset = 0;
+    }
+
+    unmapFile(data, size);
+    return ok;
+}
+
+/**
+ * @brief 保存二进制快照
+ * @details 把学生存储和课程字典按列写入STUDENTS_HEAP_FILE，并记录当前CSV文件的大小和修改时间
+ *          学生按HEAP_BLOCK_ROWS行分块计算CRC32C，并按学号在CSV文件中找出各块对应的字节区间
+ * @return 保存成功返回true，否则返回false
+ * @note 应在CSV文件保存之后调用，否则下次启动时快照会被判定为过期
+ * @note 先写入临时文件再重命名替换，保存中途崩溃时旧快照保持完整；快照可由CSV文件重建，不调用fsync
+ */
+bool saveStudentHeap()
+{
+    int courseCount = getCourseDictSize();
+
+    uint64_t stringTableSize = 0;
+    for (int i = 0; i < studentCount; i++)
+    {
+        stringTableSize += strlen(students[i].studentID) + 1;
+        stringTableSize += strlen(getStudentDetail(&students[i])->name) + 1;
+    }
+    for (int id = 0; id < courseCount; id++)
+    {
+        stringTableSize += strlen(getCourseName(id)) + 1;
+    }
+    if (stringTableSize > UINT32_MAX)
+        return false;
+
+    StudentHeapHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, STUDENT_HEAP_MAGIC, sizeof(STUDENT_HEAP_MAGIC));
+    header.version = STUDENT_HEAP_VERSION;
+    header.headerSize = sizeof(StudentHeapHeader);
+    header.studentCount = studentCount;
+    header.courseCount = courseCount;
+    header.maxCourses = MAX_COURSES;
+    header.blockRows = HEAP_BLOCK_ROWS;
+    header.stringTableSize = stringTableSize;
+    uint64_t fileSize = layoutHeapSections(&header);
+    header.payloadSize = fileSize - sizeof(StudentHeapHeader);
+
+    // 在内存中组装整个文件（对齐填充为0），计算校验和后一次写出
+    unsigned char *image = calloc(1, (size_t)fileSize);
+    if (image == NULL)
+        return false;
+
+    const uint64_t *offsets = header.sectionOffsets;
+    int32_t *ages = (int32_t *)(image + offsets[HEAP_SECTION_AGES]);
+    char *genders = (char *)(image + offsets[HEAP_SECTION_GENDERS]);
+    uint8_t *courseCounts = image + offsets[HEAP_SECTION_COURSE_COUNTS];
+    CourseId *courseIds = (CourseId *)(image + offsets[HEAP_SECTION_COURSE_IDS]);
+    Score *scores = (Score *)(image + offsets[HEAP_SECTION_SCORES]);
+    ScoreTotal *totals = (ScoreTotal *)(image + offsets[HEAP_SECTION_TOTALS]);
+    Score *averages = (Score *)(image + offsets[HEAP_SECTION_AVERAGES]);
+    uint32_t *idRefs = (uint32_t *)(image + offsets[HEAP_SECTION_ID_REFS]);
+    uint32_t *nameRefs = (uint32_t *)(image + offsets[HEAP_SECTION_NAME_REFS]);
+    uint32_t *courseNameRefs = (uint32_t *)(image + offsets[HEAP_SECTION_COURSE_NAME_REFS]);
+    StudentHeapBlock *blocks = (StudentHeapBlock *)(image + offsets[HEAP_SECTION_BLOCKS]);
+    char *strings = (char *)(image + offsets[HEAP_SECTION_STRINGS]);
+    int blockCount = heapBlockCount(studentCount, HEAP_BLOCK_ROWS);
+
+    uint64_t used = 0;
+    for (int i = 0; i < studentCount; i++)
+    {
+        const Student *student = &students[i];
+        const StudentDetail *detail = getStudentDetail(student);
+
+        if (i % HEAP_BLOCK_ROWS == 0)
+            blocks[i / HEAP_BLOCK_ROWS].stringOffset = used;
+
+        ages[i] = student->age;
+        genders[i] = student->gender;
+        courseCounts[i] = (uint8_t)detail->courseCount;
+        memcpy(courseIds + (size_t)i * MAX_COURSES, detail->courseIds, sizeof(detail->courseIds));
+        memcpy(scores + (size_t)i * MAX_COURSES, detail->scores, sizeof(detail->scores));
+        totals[i] = student->totalScore;
+        averages[i] = student->averageScore;
+        idRefs[i] = appendHeapString(strings, &used, student->studentID);
+        nameRefs[i] = appendHeapString(strings, &used, detail->name);
+    }
+    uint64_t rowStringsEnd = used;
+    for (int block = 0; block < blockCount; block++)
+    {
+        uint64_t stop = block + 1 < blockCount ? blocks[block + 1].stringOffset : rowStringsEnd;
+        blocks[block].stringSize = stop - blocks[block].stringOffset;
+    }
+    for (int id = 0; id < courseCount; id++)
+    {
+        courseNameRefs[id] = appendHeapString(strings, &used, getCourseName(id));
+    }
+
+    // 各块的校验和覆盖块内数据，文件头的校验和覆盖块表，因此最后计算
+    getFileInfo(STUDENTS_FILE, &header.sourceSize, &header.sourceModifiedTime);
+    locateHeapSources(blocks, blockCount);
+    initCrc32c();
+    StudentHeapView view;
+    mapHeapView(&view, image, &header);
+    for (int block = 0; block < blockCount; block++)
+    {
+        blocks[block].checksum = computeHeapBlockChecksum(&view, block);
+    }
+    header.checksum = computeHeapMetadataChecksum(&header, &view, rowStringsEnd);
+    memcpy(image, &header, sizeof(header));
+
+    // 快照可以由CSV文件重建，损坏时也能由校验和发现，因此只原子替换，不fsync
+    AtomicFile atomic;
+    FILE *file = openAtomicFile(&atomic, STUDENTS_HEAP_FILE, "wb");
+    bool ok = file != NULL;
+    if (ok)
+    {
+        if (fwrite(image, 1, (size_t)fileSize, file) == (size_t)fileSize)
+            ok = commitAtomicFile(&atomic, false);
+        else
+        {
+            abortAtomicFile(&atomic);
+            ok = false;
+        }
+    }
+
+    free(image);
+    return ok;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file student_id.c
+ * @brief 学号编码键实现
+ * @note 把纯数字学号压缩为64位整数键，排序、查找、哈希和查重都只需整数比较
+ */
+
+#include <string.h>
+#include "student_id.h"
+
+/**
+ * @brief 计算学号编码键
+ * @details 纯数字学号编码为 (位数 << 59) | 数值，位数参与编码，因此"007"与"7"得到不同的键
+ *          其他学号统一编码为STUDENT_KEY_NON_NUMERIC
+ * @param studentID 学号字符串
+ * @return 64位学号编码键
+ * @note 键的大小顺序：位数少的数字学号在前，同位数按数值排列（与字符串顺序一致），
+ *       非数字学号排在所有数字学号之后并按字符串排列
+ */
+uint64_t encodeStudentID(const char *studentID)
+{
+    uint64_t value = 0;
+    int length = 0;
+
+    for (const char *p = studentID; *p != '\0'; p++)
+    {
+        if (*p < '0' || *p > '9' || length == STUDENT_KEY_MAX_DIGITS)
+            return STUDENT_KEY_NON_NUMERIC;
+
+        value = value * 10 + (uint64_t)(*p - '0');
+        length++;
+    }
+
+    if (length == 0)
+        return STUDENT_KEY_NON_NUMERIC;
+
+    return ((uint64_t)length << STUDENT_KEY_LENGTH_SHIFT) | value;
+}
+
+/**
+ * @brief 比较两个学号
+ * @details 先比较编码键，只有两个学号都是非数字学号时才比较字符串
+ * @param keyA 第一个学号的编码键
+ * @param idA 第一个学号字符串
+ * @param keyB 第二个学号的编码键
+ * @param idB 第二个学号字符串
+ * @return 负数表示A<B，0表示相同，正数表示A>B
+ * @note 数字学号的键相同即表示学号完全相同，只需一次整数比较
+ */
+int compareStudentID(uint64_t keyA, const char *idA, uint64_t keyB, const char *idB)
+{
+    if (keyA != keyB)
+        return keyA < keyB ? -1 : 1;
+
+    if (keyA != STUDENT_KEY_NON_NUMERIC)
+        return 0;
+
+    return strcmp(idA, idB);
+}
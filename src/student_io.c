@@ -2,236 +2,2141 @@
  * @file student_io.c
  * @brief 学生数据文件输入输出操作实现
  * @note 负责学生数据的文件读写、CSV解析等功能
+ *       延迟加载时保留CSV文件映射，姓名和课程明细在首次访问时才从对应行解码
+ *       按列投影加载时由头部得出各字段的列号，直接读取需要的字段，其余字段不复制也不解析
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdatomic.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 #include "config.h"
 #include "globals.h"
 #include "io_utils.h"
 #include "string_utils.h"
+#include "math_utils.h"
 #include "statistical_analysis.h"
+#include "student_store.h"
+#include "course_dict.h"
+#include "file_utils.h"
+#include "async_io.h"
+#include "system_utils.h"
+#include "csv_scan.h"
+#include "validation.h"
+#include "student_io.h"
+#include "student_journal.h"
+
+// 块内课程编号的空值，标记没有解析到课程的位置
+#define CHUNK_COURSE_NONE UINT16_MAX
+
+// 成绩字段的定点上限：单科成绩和平均分不超过满分，总分不超过全部课程满分之和
+#define MAX_SCORE_VALUE ((int32_t)(MAX_SCORE * SCORE_SCALE))
+#define MAX_TOTAL_SCORE_VALUE (MAX_COURSES * MAX_SCORE_VALUE)
+
+// 学生CSV文件中的逻辑字段编号，列投影按头部把它们映射到实际的列号
+#define CSV_COLUMN_ID 0
+#define CSV_COLUMN_NAME 1
+#define CSV_COLUMN_AGE 2
+#define CSV_COLUMN_GENDER 3
+#define CSV_COLUMN_COURSE_COUNT 4
+#define CSV_COLUMN_TOTAL 5
+#define CSV_COLUMN_AVERAGE 6
+#define CSV_COLUMN_COURSES 7             // 第i门课程的名称为CSV_COLUMN_COURSES + 2i，成绩紧随其后
+#define CSV_COLUMN_COUNT (CSV_COLUMN_COURSES + 2 * MAX_COURSES)
+
+/**
+ * @brief 列投影
+ * @details 由CSV头部得出的各逻辑字段所在的列号，以及本次加载需要解析的字段
+ * @note 字段数与头部不同的行无法按列号定位，仍按顺序解析全部字段
+ */
+typedef struct {
+    LoadProjection mode;            // 投影方式，不为LOAD_COLUMNS_ALL
+    int columns[CSV_COLUMN_COUNT];  // 各逻辑字段的列号（从0开始），头部中没有的字段为-1
+    int columnCount;                // 头部的列数
+} CsvProjection;
+
+/**
+ * @brief 字段游标
+ * @details 按行索引依次读取一行中的字段
+ */
+typedef struct {
+    const char *line;               // 行起始位置
+    const CsvLineIndex *index;      // 行索引
+    int nextField;                  // 下一个字段的序号，取出字段后即为该字段的列号
+    int lineNumber;                 // 行号，用于报告格式错误
+    CsvErrorLog *errors;            // 格式错误记录
+    int problems;                   // 本行发现的问题数
+    CsvErrorKind firstProblem;      // 本行的第一个问题
+    const CsvProjection *projection; // 列投影，为NULL时按顺序读取全部字段
+} CsvFieldCursor;
+
+/**
+ * @brief 隔离的问题行
+ * @details 指向映射文件中的原始行，加载结束、解除映射之前写入STUDENTS_QUARANTINE_FILE
+ */
+typedef struct {
+    const char *line;               // 行起始位置
+    size_t length;                  // 行长度（不含换行符）
+    int lineNumber;                 // 行号（并行加载时先相对数据块，合并时换算为文件行号）
+    int problems;                   // 问题数
+    CsvErrorKind firstProblem;      // 第一个问题
+} QuarantineRow;
+
+/**
+ * @brief 问题行列表
+ * @note 内存不足时不再追加，只设置truncated
+ */
+typedef struct {
+    QuarantineRow *rows;            // 问题行，按行号顺序
+    int count;                      // 问题行数量
+    int capacity;                   // 数组容量
+    bool truncated;                 // 是否因内存不足遗漏了问题行
+} QuarantineList;
+
+/**
+ * @brief 并行加载的数据块
+ * @details 一段以换行符为边界的文件区间及其解析结果
+ *          课程名称先登记在块内的小字典中，合并时再按块的顺序登记到全局课程字典，
+ *          使课程编号与单线程加载完全一致
+ */
+typedef struct {
+    const char *start;              // 块起始位置（行首）
+    const char *end;                // 块结束位置（下一块的行首）
+    const char *base;               // 文件映射起始位置，延迟加载时用于计算行偏移，否则为NULL
+    const CsvProjection *projection; // 列投影，为NULL时解析全部字段
+    Student *records;               // 解析出的学生记录
+    StudentDetail *details;         // 对应的详细信息，courseIds为块内课程编号
+    uint64_t *sources;              // 各记录所在行相对文件开头的偏移（仅延迟加载时记录）
+    int count;                      // 已解析的记录数
+    int capacity;                   // 记录缓冲区容量
+    CsvField *courseNames;          // 块内课程名称（指向映射的文件），下标即块内课程编号
+    int courseCount;                // 块内课程数量
+    int *courseSlots;               // 块内课程哈希表，-1表示空槽
+    int courseSlotCount;            // 哈希表槽数（2的幂），名称表容量为其一半
+    int rows;                       // 扫描的行数
+    CsvErrorLog errors;             // 块内的格式错误，行号相对块起始
+    QuarantineList quarantine;      // 块内的问题行，行号相对块起始
+    bool outOfMemory;               // 解析过程中内存不足
+} LoadChunk;
+
+/**
+ * @brief 并行加载的工作队列
+ * @note 各线程通过原子计数器依次领取数据块
+ */
+typedef struct {
+    LoadChunk *chunks;              // 数据块数组，按文件顺序排列
+    int chunkCount;                 // 数据块数量
+    atomic_int nextChunk;           // 下一个待领取的数据块下标
+} LoadPool;
+
+/**
+ * @brief 并行保存的数据块
+ * @details 一段连续的学生记录及其格式化结果，缓冲区在各轮之间复用
+ */
+typedef struct {
+    int start;                      // 第一条记录的下标
+    int end;                        // 最后一条记录的下标（不包含）
+    char *buffer;                   // 格式化结果
+    size_t length;                  // 格式化结果的字节数
+    size_t capacity;                // 缓冲区容量
+    bool outOfMemory;               // 缓冲区无法扩容
+} SaveBlock;
+
+/**
+ * @brief 并行保存的工作队列
+ * @details 工作线程在一次保存中只创建一次，每轮由当前线程发布一组数据块并唤醒工作线程
+ * @note 各线程通过原子计数器依次领取数据块
+ */
+typedef struct {
+    SaveBlock *blocks;              // 本轮的数据块，按记录顺序排列
+    int blockCount;                 // 本轮的数据块数量
+    atomic_int nextBlock;           // 下一个待领取的数据块下标
+#ifndef _WIN32
+    pthread_mutex_t mutex;          // 保护以下各字段以及本轮数据块的发布
+    pthread_cond_t roundReady;      // 发布了新一轮或保存结束
+    pthread_cond_t roundDone;       // 工作线程都完成了本轮
+    int round;                      // 已发布的轮数
+    int workerCount;                // 工作线程数（不包括当前线程）
+    int busyWorkers;                // 尚未完成本轮的工作线程数
+    bool stopping;                  // 保存结束，工作线程退出
+#endif
+} SavePool;
+
+// 延迟加载时保留的CSV文件映射，没有待解码的记录时为NULL
+static const char *deferredData = NULL;
+static size_t deferredSize = 0;
+static CsvLineIndex deferredIndex;  // 解码时复用的行索引
+
+// 头部中各逻辑字段的列名，下标为CSV_COLUMN_*；课程和成绩列另按"课程N"、"成绩N"识别
+static const char *const csvColumnNames[CSV_COLUMN_COURSES] = {
+    "学号", "姓名", "年龄", "性别", "课程数量", "总分", "平均分",
+};
+
+// 各类问题的说明，下标为CsvErrorKind
+static const char *const csvErrorMessages[CSV_ERROR_KIND_COUNT] = {
+    "UTF-8编码无效",
+    "年龄格式错误",
+    "年龄超出范围",
+    "性别无效",
+    "课程数量格式错误",
+    "课程数量超出范围",
+    "成绩格式错误",
+    "成绩超出范围",
+    "总分与各科成绩之和不符",
+    "平均分与总分不符",
+};
+
+// 加载进度：已解析的字节数和本次待解析的总字节数，后台加载时由等待的线程读取
+static atomic_size_t loadedBytes;
+static atomic_size_t loadTotalBytes;
+
+/**
+ * @brief 取出一行中指定列的字段
+ * @param line 行起始位置
+ * @param index 行索引
+ * @param column 列号（从0开始，不超过index->count）
+ * @return 该列的字段，空字段的长度为0
+ */
+static CsvField csvFieldAt(const char *line, const CsvLineIndex *index, int column)
+{
+    size_t start = column == 0 ? 0 : index->delimiters[column - 1] + 1;
+    size_t stop = column < index->count ? index->delimiters[column] : index->length;
+    CsvField field = {line + start, stop - start};
+    return field;
+}
+
+/**
+ * @brief 取出一行中的下一个字段
+ * @details 按行索引中的分隔符偏移依次取出字段，与strtok一样跳过空字段，
+ *          但不修改原始数据，也不依赖静态状态，可以直接读取只读映射的文件
+ * @param cursor 字段游标，返回时移动到下一个字段
+ * @param field 输出参数，找到的字段
+ * @return 找到非空字段返回true，行内已没有字段返回false
+ */
+static bool nextCsvField(CsvFieldCursor *cursor, CsvField *field)
+{
+    const CsvLineIndex *index = cursor->index;
+    while (cursor->nextField <= index->count)
+    {
+        *field = csvFieldAt(cursor->line, index, cursor->nextField++);
+        if (field->length > 0)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 读取一行中的逻辑字段
+ * @details 没有列投影时按顺序取出下一个非空字段；有列投影时按头部得出的列号直接定位，
+ *          中间的字段不会被访问
+ * @param cursor 字段游标，返回时位于读取的字段之后
+ * @param logical 逻辑字段编号（CSV_COLUMN_*）
+ * @param field 输出参数，读取的字段
+ * @return 读取到非空字段返回true
+ */
+static bool readCsvField(CsvFieldCursor *cursor, int logical, CsvField *field)
+{
+    if (cursor->projection == NULL)
+        return nextCsvField(cursor, field);
+
+    int column = cursor->projection->columns[logical];
+    if (column < 0)
+        return false;
+
+    *field = csvFieldAt(cursor->line, cursor->index, column);
+    cursor->nextField = column + 1;
+    return field->length > 0;
+}
+
+/**
+ * @brief 判断本行是否解析各科课程和成绩
+ * @param cursor 字段游标
+ * @return 没有列投影或投影包含各科成绩时返回true
+ */
+static bool parsesCourses(const CsvFieldCursor *cursor)
+{
+    return cursor->projection == NULL || cursor->projection->mode != LOAD_COLUMNS_AGGREGATES;
+}
+
+/**
+ * @brief 识别头部列名
+ * @param name 列名字段
+ * @return 逻辑字段编号（CSV_COLUMN_*），无法识别时返回-1
+ */
+static int findCsvColumn(const CsvField *name)
+{
+    for (int logical = 0; logical < CSV_COLUMN_COURSES; logical++)
+    {
+        if (strlen(csvColumnNames[logical]) == name->length &&
+            memcmp(csvColumnNames[logical], name->start, name->length) == 0)
+            return logical;
+    }
+
+    // 课程N、成绩N（两个前缀的字节数相同）
+    size_t prefixLength = strlen("课程");
+    if (name->length <= prefixLength)
+        return -1;
+
+    bool isCourse = memcmp(name->start, "课程", prefixLength) == 0;
+    bool isScore = memcmp(name->start, "成绩", prefixLength) == 0;
+    int number;
+    if ((isCourse || isScore) &&
+        parseIntegerField(name->start + prefixLength, name->length - prefixLength, &number) &&
+        number >= 1 && number <= MAX_COURSES)
+        return CSV_COLUMN_COURSES + 2 * (number - 1) + (isScore ? 1 : 0);
+
+    return -1;
+}
+
+/**
+ * @brief 由CSV头部建立列投影
+ * @details 按列名找出各逻辑字段所在的列，之后每行按列号直接读取需要的字段
+ * @param projection 输出参数，列投影
+ * @param mode 投影方式
+ * @param header 头部行起始位置
+ * @param index 头部行的行索引
+ * @return 可以按列投影解析时返回true；mode为LOAD_COLUMNS_ALL或头部缺少需要的列时返回false，
+ *         此时应按顺序解析全部字段
+ */
+static bool buildCsvProjection(CsvProjection *projection, LoadProjection mode, const char *header,
+                               const CsvLineIndex *index)
+{
+    if (mode == LOAD_COLUMNS_ALL)
+        return false;
+
+    projection->mode = mode;
+    projection->columnCount = index->count + 1;
+    for (int logical = 0; logical < CSV_COLUMN_COUNT; logical++)
+    {
+        projection->columns[logical] = -1;
+    }
+
+    for (int column = 0; column < projection->columnCount; column++)
+    {
+        CsvField name = csvFieldAt(header, index, column);
+        int logical = findCsvColumn(&name);
+        if (logical >= 0 && projection->columns[logical] < 0)
+            projection->columns[logical] = column;
+    }
+
+    // 学号和统计字段必须存在（姓名始终跳过）
+    for (int logical = 0; logical < CSV_COLUMN_COURSES; logical++)
+    {
+        if (logical != CSV_COLUMN_NAME && projection->columns[logical] < 0)
+            return false;
+    }
+
+    // 解析各科成绩时课程列和成绩列必须成对出现
+    if (mode == LOAD_COLUMNS_SCORES)
+    {
+        for (int i = 0; i < MAX_COURSES; i++)
+        {
+            int course = projection->columns[CSV_COLUMN_COURSES + 2 * i];
+            int score = projection->columns[CSV_COLUMN_COURSES + 2 * i + 1];
+            if ((course < 0) != (score < 0))
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 复制字段内容到定长字符串
+ * @details 超出目标长度的部分被截断，结果始终以'\0'结尾
+ * @param dest 目标缓冲区
+ * @param destSize 目标缓冲区大小
+ * @param field 源字段
+ */
+static void copyCsvField(char *dest, size_t destSize, const CsvField *field)
+{
+    size_t length = field->length < destSize - 1 ? field->length : destSize - 1;
+    memcpy(dest, field->start, length);
+    dest[length] = '\0';
+}
+
+/**
+ * @brief 初始化格式错误记录
+ * @param log 要清空的错误记录
+ */
+void initCsvErrorLog(CsvErrorLog *log)
+{
+    log->count = 0;
+    log->rowCount = 0;
+    memset(log->kindCounts, 0, sizeof(log->kindCounts));
+}
+
+/**
+ * @brief 记录格式错误
+ * @details 错误总数和各类别计数始终累加，详细信息只保存前MAX_REPORTED_PARSE_ERRORS个
+ *          同时在游标上记下本行的问题数和第一个问题，供隔离问题行使用
+ * @param cursor 字段游标（提供行号、列号和错误记录）
+ * @param field 出错的字段
+ * @param kind 问题类别
+ */
+static void recordParseError(CsvFieldCursor *cursor, const CsvField *field, CsvErrorKind kind)
+{
+    CsvErrorLog *log = cursor->errors;
+    if (log->count < MAX_REPORTED_PARSE_ERRORS)
+    {
+        CsvParseError *error = &log->errors[log->count];
+        error->line = cursor->lineNumber;
+        error->column = cursor->nextField;
+        error->kind = kind;
+        error->message = csvErrorMessages[kind];
+        copyCsvField(error->text, sizeof(error->text), field);
+    }
+    log->count++;
+    log->kindCounts[kind]++;
+
+    if (cursor->problems == 0)
+    {
+        cursor->firstProblem = kind;
+        log->rowCount++;
+    }
+    cursor->problems++;
+}
+
+/**
+ * @brief 解析成绩字段并检查范围
+ * @param cursor 字段游标
+ * @param field 成绩字段
+ * @param maxScore 定点成绩上限
+ * @return 定点成绩，格式错误或超出范围时记录错误并返回0
+ */
+static int32_t parseScoreValue(CsvFieldCursor *cursor, const CsvField *field, int32_t maxScore)
+{
+    int32_t score;
+    if (!parseScoreField(field->start, field->length, &score))
+    {
+        recordParseError(cursor, field, CSV_ERROR_SCORE_FORMAT);
+        return 0;
+    }
+    if (score < (int32_t)(MIN_SCORE * SCORE_SCALE) || score > maxScore)
+    {
+        recordParseError(cursor, field, CSV_ERROR_SCORE_RANGE);
+        return 0;
+    }
+    return score;
+}
 
 /**
  * @brief 解析CSV行中的基本学生信息
- * @details 从CSV行中解析学号、姓名、年龄、性别等基本信息
+ * @details 从CSV行中解析学号、姓名、年龄、性别等基本信息，年龄和课程数量的格式和范围问题会记录到错误记录中
+ *          按列投影解析时跳过姓名，详细信息在首次访问时才完整解码
  * @param student 指向要填充的学生结构体的指针
- * @param token 当前CSV token指针的指针
+ * @param detail 指向要填充的学生详细信息的指针
+ * @param cursor 字段游标
  * @return true 解析成功，false 解析失败
  */
-static bool parseBasicStudentInfo(Student *student, char **token)
+static bool parseBasicStudentInfo(Student *student, StudentDetail *detail, CsvFieldCursor *cursor)
 {
+    CsvField field;
+
     // 学号
-    if (*token == NULL) return false;
-    strncpy(student->studentID, *token, MAX_ID_LENGTH - 1);
+    if (!readCsvField(cursor, CSV_COLUMN_ID, &field)) return false;
+    copyCsvField(student->studentID, MAX_ID_LENGTH, &field);
     
-    // 姓名
-    *token = strtok(NULL, ",");
-    if (*token == NULL) return false;
-    strncpy(student->name, *token, MAX_NAME_LENGTH - 1);
+    // 姓名（按列投影解析时跳过）
+    if (cursor->projection == NULL)
+    {
+        if (!nextCsvField(cursor, &field)) return false;
+        copyCsvField(detail->name, MAX_NAME_LENGTH, &field);
+    }
     
-    // 年龄
-    *token = strtok(NULL, ",");
-    if (*token == NULL) return false;
-    student->age = atoi(*token);
+    // 年龄（超出范围时保留原值，只报告）
+    if (!readCsvField(cursor, CSV_COLUMN_AGE, &field)) return false;
+    if (!parseIntegerField(field.start, field.length, &student->age))
+        recordParseError(cursor, &field, CSV_ERROR_AGE_FORMAT);
+    else if (!isValidAge(student->age))
+        recordParseError(cursor, &field, CSV_ERROR_AGE_RANGE);
     
-    // 性别
-    *token = strtok(NULL, ",");
-    if (*token == NULL) return false;
-    student->gender = (*token)[0];
+    // 性别（无效时保留原值，只报告）
+    if (!readCsvField(cursor, CSV_COLUMN_GENDER, &field)) return false;
+    student->gender = field.start[0];
+    if (field.length != 1 || !isValidGender(student->gender))
+        recordParseError(cursor, &field, CSV_ERROR_GENDER);
     
-    // 课程数量
-    *token = strtok(NULL, ",");
-    if (*token == NULL) return false;
-    student->courseCount = atoi(*token);
+    // 课程数量（超过上限时截断，避免越界访问课程数组）
+    if (!readCsvField(cursor, CSV_COLUMN_COURSE_COUNT, &field)) return false;
+    if (!parseIntegerField(field.start, field.length, &detail->courseCount))
+    {
+        recordParseError(cursor, &field, CSV_ERROR_COURSE_COUNT_FORMAT);
+    }
+    else if (detail->courseCount > MAX_COURSES)
+    {
+        recordParseError(cursor, &field, CSV_ERROR_COURSE_COUNT_RANGE);
+        detail->courseCount = MAX_COURSES;
+    }
     
     return true;
 }
 
+/**
+ * @brief 计算课程名称字段的哈希值
+ * @details 使用FNV-1a算法，与课程字典相同
+ * @param name 名称起始地址
+ * @param length 名称字节数
+ * @return 32位哈希值
+ */
+static uint32_t hashCourseField(const char *name, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (unsigned char)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief 扩大块内课程字典
+ * @details 槽数翻倍（初始16），名称表容量随之扩大，并重新插入所有名称
+ * @param chunk 数据块
+ * @return 成功返回true，内存不足返回false
+ */
+static bool growChunkCourses(LoadChunk *chunk)
+{
+    int slotCount = chunk->courseSlotCount == 0 ? 16 : chunk->courseSlotCount * 2;
+    int *slots = malloc((size_t)slotCount * sizeof(int));
+    CsvField *names = realloc(chunk->courseNames, (size_t)(slotCount / 2) * sizeof(CsvField));
+    if (slots == NULL || names == NULL)
+    {
+        free(slots);
+        if (names != NULL)
+            chunk->courseNames = names;
+        return false;
+    }
+
+    memset(slots, -1, (size_t)slotCount * sizeof(int));
+    for (int id = 0; id < chunk->courseCount; id++)
+    {
+        int slot = (int)(hashCourseField(names[id].start, names[id].length) & (uint32_t)(slotCount - 1));
+        while (slots[slot] != -1)
+            slot = (slot + 1) & (slotCount - 1);
+        slots[slot] = id;
+    }
+
+    free(chunk->courseSlots);
+    chunk->courseSlots = slots;
+    chunk->courseSlotCount = slotCount;
+    chunk->courseNames = names;
+    return true;
+}
+
+/**
+ * @brief 在块内课程字典中登记课程名称
+ * @details 与internCourse()规则相同：超长的名称按截断后的内容比较，编号按首次出现的顺序分配
+ * @param chunk 数据块
+ * @param field 课程名称字段
+ * @return 块内课程编号，内存不足或字典已满时返回-1
+ */
+static int internChunkCourse(LoadChunk *chunk, const CsvField *field)
+{
+    size_t length = field->length < MAX_COURSE_NAME_LENGTH - 1 ? field->length : MAX_COURSE_NAME_LENGTH - 1;
+
+    // 保持装载因子不超过1/2，同时保证名称表有空位
+    if (chunk->courseCount * 2 >= chunk->courseSlotCount && !growChunkCourses(chunk))
+    {
+        chunk->outOfMemory = true;
+        return -1;
+    }
+
+    int mask = chunk->courseSlotCount - 1;
+    int slot = (int)(hashCourseField(field->start, length) & (uint32_t)mask);
+    while (chunk->courseSlots[slot] != -1)
+    {
+        const CsvField *name = &chunk->courseNames[chunk->courseSlots[slot]];
+        if (name->length == length && memcmp(name->start, field->start, length) == 0)
+            return chunk->courseSlots[slot];
+        slot = (slot + 1) & mask;
+    }
+
+    if (chunk->courseCount >= MAX_COURSE_DICT_SIZE)
+        return -1;
+
+    int id = chunk->courseCount++;
+    chunk->courseNames[id].start = field->start;
+    chunk->courseNames[id].length = length;
+    chunk->courseSlots[slot] = id;
+    return id;
+}
+
+/**
+ * @brief 在全局课程字典中登记课程名称字段
+ * @param field 课程名称字段
+ * @return 课程编号，内存不足或字典已满时返回-1
+ */
+static int internCourseField(const CsvField *field)
+{
+    char courseName[MAX_COURSE_NAME_LENGTH];
+    copyCsvField(courseName, sizeof(courseName), field);
+    return internCourse(courseName);
+}
+
 /**
  * @brief 解析CSV行中的课程信息
- * @details 从CSV行中解析课程名称和成绩信息
- * @param student 指向要填充的学生结构体的指针
- * @param token 当前CSV token指针的指针
+ * @details 从CSV行中解析课程名称和成绩信息，课程名称登记到课程字典后只保存编号
+ *          成绩格式错误或超出范围时记录错误并按0处理
+ * @param detail 指向要填充的学生详细信息的指针
+ * @param cursor 字段游标
+ * @param chunk 所属的并行加载数据块，为NULL时直接登记到全局课程字典
+ * @return 已登记课程编号的课程数；列投影不含各科成绩时不解析，返回0
  */
-static void parseCourseInfo(Student *student, char **token)
+static int parseCourseInfo(StudentDetail *detail, CsvFieldCursor *cursor, LoadChunk *chunk)
 {
+    CsvField field;
+    int parsed = 0;
+    if (!parsesCourses(cursor))
+        return 0;
+
     // 课程和成绩
-    for (int i = 0; i < student->courseCount && i < MAX_COURSES; i++)
+    for (int i = 0; i < detail->courseCount && i < MAX_COURSES; i++)
     {
         // 课程名称
-        *token = strtok(NULL, ",");
-        if (*token == NULL) break;
-        strncpy(student->courses[i], *token, MAX_COURSE_NAME_LENGTH - 1);
+        if (!readCsvField(cursor, CSV_COLUMN_COURSES + 2 * i, &field)) break;
+        int courseId = chunk != NULL ? internChunkCourse(chunk, &field) : internCourseField(&field);
+        if (courseId < 0) break;
+        detail->courseIds[i] = (CourseId)courseId;
+        parsed = i + 1;
         
         // 成绩
-        *token = strtok(NULL, ",");
-        if (*token == NULL) break;
-        student->scores[i] = atof(*token);
+        if (!readCsvField(cursor, CSV_COLUMN_COURSES + 2 * i + 1, &field)) break;
+        detail->scores[i] = (Score)parseScoreValue(cursor, &field, MAX_SCORE_VALUE);
     }
+
+    return parsed;
 }
 
 /**
  * @brief 解析CSV行中的统计信息
- * @details 从CSV行中解析总分和平均分信息
+ * @details 从CSV行中解析总分和平均分信息，直接解析为定点数，并与按各科成绩重新计算的结果交叉校验
+ *          总分必须等于各科成绩之和，平均分与重新计算的结果最多相差AVERAGE_CHECK_TOLERANCE
  * @param student 指向要填充的学生结构体的指针
- * @param token 当前CSV token指针的指针
+ * @param detail 学生详细信息，提供各科成绩
+ * @param cursor 字段游标
+ * @note 总分取重新计算的结果；平均分在容差以内时保留文件中的值，否则取重新计算的结果
+ * @note 只有解析成功但数值不符时才报告不符，格式错误或超出范围已经单独报告
+ * @note 列投影不含各科成绩时无法交叉校验，总分和平均分直接取文件中的值，只检查格式和范围
  */
-static void parseStatisticsInfo(Student *student, char **token)
+static void parseStatisticsInfo(Student *student, const StudentDetail *detail, CsvFieldCursor *cursor)
 {
+    CsvField field;
+    Student expected;
+    bool crossCheck = parsesCourses(cursor);
+    if (crossCheck)
+        calculateStudentStats(&expected, detail);
+    else
+        memset(&expected, 0, sizeof(Student));
+
     // 总分
-    *token = strtok(NULL, ",");
-    if (*token != NULL)
+    if (readCsvField(cursor, CSV_COLUMN_TOTAL, &field))
     {
-        student->totalScore = atof(*token);
+        int problems = cursor->problems;
+        int32_t total = parseScoreValue(cursor, &field, MAX_TOTAL_SCORE_VALUE);
+        if (!crossCheck)
+            expected.totalScore = total;
+        else if (cursor->problems == problems && total != expected.totalScore)
+            recordParseError(cursor, &field, CSV_ERROR_TOTAL_MISMATCH);
     }
     
-    // 平均分
-    *token = strtok(NULL, ",");
-    if (*token != NULL)
+    student->totalScore = expected.totalScore;
+    student->averageScore = expected.averageScore;
+
+    // 平均分（容差以内时保留文件中的值）
+    if (readCsvField(cursor, CSV_COLUMN_AVERAGE, &field))
     {
-        student->averageScore = atof(*token);
+        int problems = cursor->problems;
+        int32_t average = parseScoreValue(cursor, &field, MAX_SCORE_VALUE);
+        if (cursor->problems != problems)
+            return;
+        if (crossCheck && abs(average - expected.averageScore) > AVERAGE_CHECK_TOLERANCE)
+            recordParseError(cursor, &field, CSV_ERROR_AVERAGE_MISMATCH);
+        else
+            student->averageScore = (Score)average;
     }
 }
 
 /**
  * @brief 解析单行CSV学生数据
- * @details 解析一行CSV数据并填充学生结构体
- * @param line CSV行数据
+ * @details 解析一行CSV数据并填充学生结构体，字段直接从原始数据中读取，不复制整行
+ * @param cursor 指向行首的字段游标
  * @param student 指向要填充的学生结构体的指针
+ * @param detail 指向要填充的学生详细信息的指针
+ * @param chunk 所属的并行加载数据块，为NULL时课程直接登记到全局课程字典
  * @return true 解析成功，false 解析失败
+ * @note chunk不为NULL时，课程编号为块内编号，没有课程的位置填CHUNK_COURSE_NONE
+ * @note 游标带有列投影时只解析投影包含的字段；字段数与头部不同的行仍按顺序解析全部字段
  */
-static bool parseStudentLine(char *line, Student *student)
+static bool parseStudentLine(CsvFieldCursor *cursor, Student *student, StudentDetail *detail, LoadChunk *chunk)
 {
     memset(student, 0, sizeof(Student));
-    
-    // 解析CSV行
-    char *token = strtok(line, ",");
-    if (token == NULL) return false;
+    memset(detail, 0, sizeof(StudentDetail));
+
+    if (cursor->projection != NULL && cursor->index->count + 1 != cursor->projection->columnCount)
+        cursor->projection = NULL;
     
     // 解析基本信息
-    if (!parseBasicStudentInfo(student, &token)) return false;
+    if (!parseBasicStudentInfo(student, detail, cursor)) return false;
     
     // 解析课程信息
-    parseCourseInfo(student, &token);
+    int parsed = parseCourseInfo(detail, cursor, chunk);
+    if (chunk != NULL)
+    {
+        for (int i = parsed; i < MAX_COURSES; i++)
+        {
+            detail->courseIds[i] = CHUNK_COURSE_NONE;
+        }
+    }
     
-    // 解析统计信息
-    parseStatisticsInfo(student, &token);
+    // 解析统计信息并交叉校验
+    parseStatisticsInfo(student, detail, cursor);
     
     return true;
 }
 
 /**
- * @brief 从CSV文件加载学生数据
- * @details 从STUDENTS_FILE指定的CSV文件中读取学生信息并加载到内存中
- *          解析CSV格式数据，包括学号、姓名、年龄、性别、课程信息等
- *          如果文件不存在，会初始化为空的学生列表
- * @note 会跳过CSV文件的头部行，最多加载MAX_STUDENTS个学生
- * @note 加载完成后会设置statsNeedUpdate标志为true
- * @warning 如果CSV格式不正确，可能导致数据解析错误
- * @see STUDENTS_FILE, MAX_STUDENTS, Student结构体
+ * @brief 把问题行加入隔离列表
+ * @param list 问题行列表
+ * @param cursor 该行的字段游标，提供行起始位置、长度、行号和问题
  */
-void loadStudentsFromFile()
+static void quarantineRow(QuarantineList *list, const CsvFieldCursor *cursor)
 {
-    FILE *file = fopen(STUDENTS_FILE, "r");
-    if (file == NULL)
+    if (list->count == list->capacity)
     {
-        studentCount = 0;
-        printInfo("学生数据文件不存在，将创建新文件。");
-        return;
+        int capacity = list->capacity == 0 ? 16 : list->capacity * 2;
+        QuarantineRow *rows = realloc(list->rows, (size_t)capacity * sizeof(QuarantineRow));
+        if (rows == NULL)
+        {
+            list->truncated = true;
+            return;
+        }
+        list->rows = rows;
+        list->capacity = capacity;
     }
-    
-    char line[1024];
-    studentCount = 0;
-    
-    // 跳过CSV头部
-    if (fgets(line, sizeof(line), file) == NULL)
-    {
-        fclose(file);
-        studentCount = 0;
+
+    QuarantineRow *row = &list->rows[list->count++];
+    row->line = cursor->line;
+    row->length = cursor->index->length;
+    row->lineNumber = cursor->lineNumber;
+    row->problems = cursor->problems;
+    row->firstProblem = cursor->firstProblem;
+}
+
+/**
+ * @brief 合并问题行列表
+ * @param into 目标列表
+ * @param from 数据块的问题行列表
+ * @param lineOffset 数据块第一行之前的行数，用于把块内行号换算为文件行号
+ */
+static void mergeQuarantineList(QuarantineList *into, const QuarantineList *from, int lineOffset)
+{
+    into->truncated = into->truncated || from->truncated;
+    if (from->count == 0)
         return;
-    }
-    
-    // 读取学生数据
-    while (fgets(line, sizeof(line), file) != NULL && studentCount < MAX_STUDENTS)
+
+    if (into->count + from->count > into->capacity)
     {
-        Student *student = &students[studentCount];
-        
-        if (parseStudentLine(line, student))
+        QuarantineRow *rows = realloc(into->rows, (size_t)(into->count + from->count) * sizeof(QuarantineRow));
+        if (rows == NULL)
         {
-            studentCount++;
+            into->truncated = true;
+            return;
         }
+        into->rows = rows;
+        into->capacity = into->count + from->count;
+    }
+
+    for (int i = 0; i < from->count; i++)
+    {
+        into->rows[into->count] = from->rows[i];
+        into->rows[into->count].lineNumber += lineOffset;
+        into->count++;
     }
-    
-    fclose(file);
-    
-    // 更新统计信息
-    statsNeedUpdate = true;
-    
-    // 使统计缓存无效
-    invalidateCache();
 }
 
 /**
- * @brief 将学生数据保存到CSV文件
- * @details 将内存中的所有学生数据以CSV格式保存到STUDENTS_FILE文件中
- *          包含完整的CSV头部和所有学生的详细信息
- *          保存成功后会重置dataModified标志
- * @note CSV格式包括：学号、姓名、年龄、性别、课程数量、各课程名称和成绩、总分、平均分
- * @note 对于课程数量不足MAX_COURSES的学生，会用空值填充
- * @warning 如果文件无法创建或写入，会显示错误信息
- * @see STUDENTS_FILE, MAX_COURSES, dataModified
+ * @brief 释放问题行列表
+ * @param list 问题行列表
  */
-void saveStudentsToFile()
+static void freeQuarantineList(QuarantineList *list)
 {
-    FILE *file = fopen(STUDENTS_FILE, "w");
-    if (file == NULL)
-    {
-        printError("无法保存学生数据！");
-        return;
-    }
+    free(list->rows);
+    list->rows = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
 
-    // 写入CSV头部
-    fprintf(file, "学号,姓名,年龄,性别,课程数量");
-    for (int i = 0; i < MAX_COURSES; i++)
+/**
+ * @brief 校验一行的UTF-8编码
+ * @details 所在数据区间整体校验未通过时才逐行调用；编码无效时找出第一个含无效字节的字段并记录错误
+ * @param cursor 指向行首的字段游标
+ * @return 编码合法返回true
+ */
+static bool checkLineEncoding(CsvFieldCursor *cursor)
+{
+    if (validateUtf8(cursor->line, cursor->index->length))
+        return true;
+
+    CsvField field = {cursor->line, cursor->index->length};
+    CsvField candidate;
+    while (nextCsvField(cursor, &candidate))
     {
-        fprintf(file, ",课程%d,成绩%d", i + 1, i + 1);
+        if (!validateUtf8(candidate.start, candidate.length))
+        {
+            field = candidate;
+            break;
+        }
     }
-    fprintf(file, ",总分,平均分\n");
+    recordParseError(cursor, &field, CSV_ERROR_INVALID_UTF8);
+    return false;
+}
+
+/**
+ * @brief 单线程加载学生数据
+ * @details 逐行建立字段索引并解析，直接写入学生数组末尾的空闲位置
+ *          延迟加载时只把统计字段写入学生存储，详细信息记为行偏移
+ *          先用向量化校验器检查整个区间的UTF-8编码，未通过时再逐行检查，编码无效的行不加载
+ * @param base 文件映射起始位置，延迟加载时用于计算行偏移，否则为NULL
+ * @param data 第一行数据的起始位置（已跳过头部）
+ * @param end 数据结束位置
+ * @param projection 列投影，为NULL时解析全部字段
+ * @param errors 格式错误记录
+ * @param quarantine 问题行列表
+ * @return 扫描的数据行数
+ */
+static int loadStudentsSequential(const char *base, const char *data, const char *end,
+                                  const CsvProjection *projection, CsvErrorLog *errors,
+                                  QuarantineList *quarantine)
+{
+    int rows = 0;
+    CsvLineIndex index;
+    initCsvLineIndex(&index);
+    bool checkEncoding = !validateUtf8(data, (size_t)(end - data));
 
-    // 写入学生数据
-    for (int i = 0; i < studentCount; i++)
+    const char *cursor = data;
+    while (cursor < end)
     {
-        Student *student = &students[i];
+        const char *nextLine;
+        if (!indexCsvLine(cursor, end, &index, &nextLine))
+        {
+            printError("内存不足，学生数据未能全部加载！");
+            break;
+        }
+        rows++;
+        if (rows % LOAD_PROGRESS_ROWS == 0)
+        {
+            atomic_store(&loadedBytes, (size_t)(cursor - data));
+        }
 
-        // 基本信息
-        fprintf(file, "%s,%s,%d,%c,%d",
-                student->studentID,
-                student->name,
-                student->age,
-                student->gender,
-                student->courseCount);
+        // 头部为第1行，第一条数据为第2行
+        CsvFieldCursor fields = {cursor, &index, 0, rows + 1, errors, 0, 0, projection};
+        if (checkEncoding && !checkLineEncoding(&fields))
+        {
+            quarantineRow(quarantine, &fields);
+            cursor = nextLine;
+            continue;
+        }
 
-        // 课程和成绩
-        for (int j = 0; j < MAX_COURSES; j++)
+        if (base != NULL)
         {
-            if (j < student->courseCount)
-            {
-                fprintf(file, ",%s,%.2f", student->courses[j], student->scores[j]);
-            }
-            else
+            Student student;
+            StudentDetail detail;
+            bool parsed = parseStudentLine(&fields, &student, &detail, NULL);
+            if (fields.problems > 0)
+                quarantineRow(quarantine, &fields);
+            if (parsed && !appendDeferredStudent(&student, &detail, (uint64_t)(cursor - base)))
             {
-                fprintf(file, ",,"); // 空的课程和成绩
+                printError("内存不足，学生数据未能全部加载！");
+                break;
             }
+            cursor = nextLine;
+            continue;
+        }
+
+        // 直接解析到数组末尾的空闲位置，避免额外拷贝
+        StudentDetail *detail;
+        Student *student = beginAppendStudent(&detail);
+        if (student == NULL)
+        {
+            printError("内存不足，学生数据未能全部加载！");
+            break;
+        }
+        
+        bool parsed = parseStudentLine(&fields, student, detail, NULL);
+        if (fields.problems > 0)
+            quarantineRow(quarantine, &fields);
+        if (parsed && !commitAppendStudent())
+        {
+            printError("内存不足，学生数据未能全部加载！");
+            break;
         }
 
-        // 总分和平均分
-        fprintf(file, ",%.2f,%.2f\n", student->totalScore, student->averageScore);
+        cursor = nextLine;
     }
 
-    fclose(file);
-    dataModified = false;
+    freeCsvLineIndex(&index);
+    return rows;
+}
+
+/**
+ * @brief 扩大数据块的记录缓冲区
+ * @details 初始容量按块大小估算（约每100字节一条记录），之后倍增
+ * @param chunk 数据块
+ * @return 成功返回true，内存不足返回false
+ */
+static bool growLoadChunk(LoadChunk *chunk)
+{
+    int capacity = chunk->capacity == 0 ? (int)((chunk->end - chunk->start) / 100) + 16 : chunk->capacity * 2;
+    Student *records = realloc(chunk->records, (size_t)capacity * sizeof(Student));
+    if (records == NULL)
+        return false;
+    chunk->records = records;
+
+    StudentDetail *details = realloc(chunk->details, (size_t)capacity * sizeof(StudentDetail));
+    if (details == NULL)
+        return false;
+    chunk->details = details;
+
+    if (chunk->base != NULL)
+    {
+        uint64_t *sources = realloc(chunk->sources, (size_t)capacity * sizeof(uint64_t));
+        if (sources == NULL)
+            return false;
+        chunk->sources = sources;
+    }
+
+    chunk->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief 解析一个数据块
+ * @details 把块内各行解析到块自己的缓冲区，课程登记到块内课程字典，不访问任何全局数据
+ *          UTF-8编码先按整块校验，未通过时再逐行检查
+ * @param chunk 数据块
+ */
+static void parseLoadChunk(LoadChunk *chunk)
+{
+    CsvLineIndex index;
+    initCsvLineIndex(&index);
+    bool checkEncoding = !validateUtf8(chunk->start, (size_t)(chunk->end - chunk->start));
+
+    const char *cursor = chunk->start;
+    const char *reported = cursor;
+    while (cursor < chunk->end && !chunk->outOfMemory)
+    {
+        const char *nextLine;
+        if (!indexCsvLine(cursor, chunk->end, &index, &nextLine) ||
+            (chunk->count == chunk->capacity && !growLoadChunk(chunk)))
+        {
+            chunk->outOfMemory = true;
+            break;
+        }
+        chunk->rows++;
+        if (chunk->rows % LOAD_PROGRESS_ROWS == 0)
+        {
+            atomic_fetch_add(&loadedBytes, (size_t)(cursor - reported));
+            reported = cursor;
+        }
+
+        CsvFieldCursor fields = {cursor, &index, 0, chunk->rows, &chunk->errors, 0, 0, chunk->projection};
+        if (checkEncoding && !checkLineEncoding(&fields))
+        {
+            quarantineRow(&chunk->quarantine, &fields);
+            cursor = nextLine;
+            continue;
+        }
+
+        if (parseStudentLine(&fields, &chunk->records[chunk->count], &chunk->details[chunk->count], chunk))
+        {
+            if (chunk->base != NULL)
+                chunk->sources[chunk->count] = (uint64_t)(cursor - chunk->base);
+            chunk->count++;
+        }
+        if (fields.problems > 0)
+            quarantineRow(&chunk->quarantine, &fields);
+
+        cursor = nextLine;
+    }
+
+    freeCsvLineIndex(&index);
+}
+
+/**
+ * @brief 加载线程入口
+ * @details 从工作队列中依次领取数据块并解析，直到所有数据块都被领取
+ * @param arg 工作队列（LoadPool）
+ * @return 总是返回NULL
+ */
+static void *loadWorker(void *arg)
+{
+    LoadPool *pool = arg;
+    int index;
+    while ((index = atomic_fetch_add(&pool->nextChunk, 1)) < pool->chunkCount)
+    {
+        parseLoadChunk(&pool->chunks[index]);
+    }
+    return NULL;
+}
+
+/**
+ * @brief 把块内课程编号换算为全局课程编号
+ * @param detail 学生详细信息
+ * @param courseMap 块内编号到全局编号的映射，-1表示全局字典登记失败
+ */
+static void remapChunkCourses(StudentDetail *detail, const int *courseMap)
+{
+    for (int i = 0; i < MAX_COURSES; i++)
+    {
+        if (detail->courseIds[i] == CHUNK_COURSE_NONE)
+        {
+            detail->courseIds[i] = 0;
+            continue;
+        }
+
+        int courseId = courseMap[detail->courseIds[i]];
+        if (courseId < 0)
+        {
+            // 与单线程加载一致：课程登记失败时，从这门课程开始不再记录
+            for (; i < MAX_COURSES; i++)
+            {
+                detail->courseIds[i] = 0;
+                detail->scores[i] = 0;
+            }
+            break;
+        }
+        detail->courseIds[i] = (CourseId)courseId;
+    }
+}
+
+/**
+ * @brief 合并一个数据块
+ * @details 按块内编号顺序把课程登记到全局课程字典，换算记录中的课程编号后追加到学生存储
+ *          延迟加载时详细信息只用于填充列式视图，学生存储中记录的是行偏移
+ * @param chunk 数据块
+ * @return 成功返回true，内存不足返回false
+ */
+static bool mergeLoadChunk(LoadChunk *chunk)
+{
+    int *courseMap = malloc((size_t)(chunk->courseCount > 0 ? chunk->courseCount : 1) * sizeof(int));
+    if (courseMap == NULL)
+        return false;
+
+    for (int id = 0; id < chunk->courseCount; id++)
+    {
+        courseMap[id] = internCourseField(&chunk->courseNames[id]);
+    }
+
+    bool ok = true;
+    for (int i = 0; ok && i < chunk->count; i++)
+    {
+        remapChunkCourses(&chunk->details[i], courseMap);
+        if (chunk->base != NULL)
+            ok = appendDeferredStudent(&chunk->records[i], &chunk->details[i], chunk->sources[i]);
+        else
+            ok = appendStudent(&chunk->records[i], &chunk->details[i]) != NULL;
+    }
+
+    free(courseMap);
+    return ok;
+}
+
+/**
+ * @brief 合并格式错误记录
+ * @param into 目标错误记录
+ * @param from 数据块的错误记录
+ * @param lineOffset 数据块第一行之前的行数，用于把块内行号换算为文件行号
+ */
+static void mergeErrorLog(CsvErrorLog *into, const CsvErrorLog *from, int lineOffset)
+{
+    int stored = from->count < MAX_REPORTED_PARSE_ERRORS ? from->count : MAX_REPORTED_PARSE_ERRORS;
+    for (int i = 0; i < stored && into->count + i < MAX_REPORTED_PARSE_ERRORS; i++)
+    {
+        into->errors[into->count + i] = from->errors[i];
+        into->errors[into->count + i].line += lineOffset;
+    }
+    into->count += from->count;
+    into->rowCount += from->rowCount;
+    for (int kind = 0; kind < CSV_ERROR_KIND_COUNT; kind++)
+    {
+        into->kindCounts[kind] += from->kindCounts[kind];
+    }
+}
+
+/**
+ * @brief 释放数据块的缓冲区
+ * @param chunk 数据块
+ */
+static void freeLoadChunk(LoadChunk *chunk)
+{
+    free(chunk->records);
+    free(chunk->details);
+    free(chunk->sources);
+    free(chunk->courseNames);
+    free(chunk->courseSlots);
+    freeQuarantineList(&chunk->quarantine);
+    chunk->records = NULL;
+    chunk->details = NULL;
+    chunk->sources = NULL;
+    chunk->courseNames = NULL;
+    chunk->courseSlots = NULL;
+}
+
+/**
+ * @brief 多线程加载学生数据
+ * @details 按换行符把数据切分为threadCount * LOAD_CHUNKS_PER_THREAD个数据块，
+ *          由线程池并行解析到各块自己的缓冲区，再按文件顺序合并到学生存储
+ * @param base 文件映射起始位置，延迟加载时用于计算行偏移，否则为NULL
+ * @param data 第一行数据的起始位置（已跳过头部）
+ * @param end 数据结束位置
+ * @param threadCount 线程数（包括当前线程）
+ * @param projection 列投影，为NULL时解析全部字段
+ * @param errors 格式错误记录，各块的错误按文件顺序合并到其中
+ * @param quarantine 问题行列表，各块的问题行按文件顺序合并到其中
+ * @return 扫描的数据行数，内存不足无法切分时返回-1且不加载任何数据
+ * @note 合并结果（记录顺序、课程编号、问题行）与单线程加载完全相同
+ */
+static int loadStudentsParallel(const char *base, const char *data, const char *end, int threadCount,
+                                const CsvProjection *projection, CsvErrorLog *errors,
+                                QuarantineList *quarantine)
+{
+    int chunkCount = threadCount * LOAD_CHUNKS_PER_THREAD;
+    LoadChunk *chunks = calloc((size_t)chunkCount, sizeof(LoadChunk));
+    if (chunks == NULL)
+        return -1;
+
+    // 按字节均分，再把每个分界点推进到下一行行首
+    size_t bytes = (size_t)(end - data);
+    const char *cursor = data;
+    for (int i = 0; i < chunkCount; i++)
+    {
+        chunks[i].start = cursor;
+        chunks[i].base = base;
+        chunks[i].projection = projection;
+        const char *target = data + bytes / (size_t)chunkCount * (size_t)(i + 1);
+        if (i == chunkCount - 1 || target >= end)
+        {
+            cursor = end;
+        }
+        else if (target > cursor)
+        {
+            const char *newline = memchr(target, '\n', (size_t)(end - target));
+            cursor = newline != NULL ? newline + 1 : end;
+        }
+        chunks[i].end = cursor;
+    }
+
+    LoadPool pool;
+    pool.chunks = chunks;
+    pool.chunkCount = chunkCount;
+    atomic_init(&pool.nextChunk, 0);
+
+#ifndef _WIN32
+    // 线程创建失败时由其余线程（至少有当前线程）完成剩余的数据块
+    pthread_t threads[MAX_LOAD_THREADS];
+    int started = 0;
+    for (int i = 1; i < threadCount; i++)
+    {
+        if (pthread_create(&threads[started], NULL, loadWorker, &pool) == 0)
+            started++;
+    }
+#endif
+
+    loadWorker(&pool);
+
+#ifndef _WIN32
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+#endif
+
+    // 按文件顺序合并，课程编号因此与单线程加载时的首次出现顺序一致
+    int total = 0;
+    for (int i = 0; i < chunkCount; i++)
+    {
+        total += chunks[i].count;
+    }
+    reserveStudents(total);
+
+    int rows = 0;
+    bool ok = true;
+    for (int i = 0; i < chunkCount; i++)
+    {
+        // 头部占第1行
+        mergeErrorLog(errors, &chunks[i].errors, rows + 1);
+        mergeQuarantineList(quarantine, &chunks[i].quarantine, rows + 1);
+        rows += chunks[i].rows;
+        if (ok)
+        {
+            ok = mergeLoadChunk(&chunks[i]) && !chunks[i].outOfMemory;
+        }
+        freeLoadChunk(&chunks[i]);
+    }
+
+    if (!ok)
+    {
+        printError("内存不足，学生数据未能全部加载！");
+    }
+
+    free(chunks);
+    return rows;
+}
+
+/**
+ * @brief 确定加载线程数
+ * @details 使用--threads=N指定的线程数；未指定时按CPU核数自动选择，
+ *          但小于PARALLEL_LOAD_MIN_BYTES的文件单线程加载，避免创建线程的开销超过收益
+ * @param bytes 待解析的字节数
+ * @return 线程数（1到MAX_LOAD_THREADS）
+ */
+static int chooseLoadThreads(size_t bytes)
+{
+#ifdef _WIN32
+    // Windows下没有pthread，始终单线程加载
+    (void)bytes;
+    return 1;
+#else
+    if (runtimeOptions.loadThreads > 0)
+        return runtimeOptions.loadThreads;
+
+    if (bytes < PARALLEL_LOAD_MIN_BYTES)
+        return 1;
+
+    int threads = getProcessorCount();
+    return threads < MAX_LOAD_THREADS ? threads : MAX_LOAD_THREADS;
+#endif
+}
+
+/**
+ * @brief 输出加载吞吐量
+ * @param bytes 读取的字节数
+ * @param rows 扫描的数据行数
+ * @param threads 加载线程数
+ * @param seconds 耗时（秒）
+ */
+static void reportLoadThroughput(size_t bytes, int rows, int threads, double seconds)
+{
+    // 计时精度不足时按1微秒计算，避免除零
+    if (seconds < 1e-6)
+        seconds = 1e-6;
+
+    double megabytes = (double)bytes / (1024.0 * 1024.0);
+    fprintf(messageStream(), "已加载 %d 名学生（%d 行，%.2f MB，%d 线程，%s扫描），耗时 %.3f 秒，%.1f MB/s，%.0f 行/秒\n",
+            studentCount, rows, megabytes, threads, getCsvScannerName(), seconds, megabytes / seconds, rows / seconds);
+}
+
+/**
+ * @brief 写入问题行隔离文件
+ * @details 第一行为"行号,问题数,首个问题,"加上原文件的头部，之后每个问题行一行，
+ *          原始内容原样保留在前三列之后，去掉前三列即可放回学生数据文件
+ * @param header 原文件头部行
+ * @param headerLength 头部行长度（不含换行符）
+ * @param list 问题行列表
+ * @return 写入成功返回true
+ */
+static bool writeQuarantineFile(const char *header, size_t headerLength, const QuarantineList *list)
+{
+    FILE *file = fopen(STUDENTS_QUARANTINE_FILE, "wb");
+    if (file == NULL)
+        return false;
+
+    fputs("行号,问题数,首个问题,", file);
+    fwrite(header, 1, headerLength, file);
+    fputc('\n', file);
+    for (int i = 0; i < list->count; i++)
+    {
+        const QuarantineRow *row = &list->rows[i];
+        fprintf(file, "%d,%d,%s,", row->lineNumber, row->problems, csvErrorMessages[row->firstProblem]);
+        fwrite(row->line, 1, row->length, file);
+        fputc('\n', file);
+    }
+
+    bool ok = !ferror(file);
+    if (fclose(file) != 0)
+        ok = false;
+    return ok;
+}
+
+/**
+ * @brief 输出加载时的校验报告
+ * @details 先输出问题行数和各类问题的数量，再逐条列出前MAX_REPORTED_PARSE_ERRORS个问题
+ * @param errors 格式错误记录
+ * @param quarantine 问题行列表
+ * @param quarantined 问题行是否已写入隔离文件
+ */
+static void reportParseErrors(const CsvErrorLog *errors, const QuarantineList *quarantine, bool quarantined)
+{
+    if (errors->count == 0)
+        return;
+
+    printWarning("学生数据文件校验发现问题（超出范围的成绩按0处理，不符的总分和平均分按各科成绩重新计算）：");
+    fprintf(messageStream(), "  共 %d 行存在问题", errors->rowCount);
+    if (errors->kindCounts[CSV_ERROR_INVALID_UTF8] > 0)
+    {
+        fprintf(messageStream(), "，其中 %d 行编码无效，未加载", errors->kindCounts[CSV_ERROR_INVALID_UTF8]);
+    }
+    fprintf(messageStream(), "\n");
+    for (int kind = 0; kind < CSV_ERROR_KIND_COUNT; kind++)
+    {
+        if (errors->kindCounts[kind] > 0)
+        {
+            fprintf(messageStream(), "    %s：%d 处\n", csvErrorMessages[kind], errors->kindCounts[kind]);
+        }
+    }
+
+    int shown = errors->count < MAX_REPORTED_PARSE_ERRORS ? errors->count : MAX_REPORTED_PARSE_ERRORS;
+    for (int i = 0; i < shown; i++)
+    {
+        const CsvParseError *error = &errors->errors[i];
+        fprintf(messageStream(), "  第%d行第%d列：%s（%s）\n", error->line, error->column, error->message, error->text);
+    }
+    if (errors->count > shown)
+    {
+        fprintf(messageStream(), "  另有 %d 处错误未显示\n", errors->count - shown);
+    }
+
+    if (quarantined)
+    {
+        fprintf(messageStream(), "  问题行的原始内容已保存到 %s\n", STUDENTS_QUARANTINE_FILE);
+    }
+    else if (quarantine->count > 0)
+    {
+        printWarning("无法写入问题行隔离文件！");
+    }
+    if (quarantine->truncated)
+    {
+        printWarning("内存不足，部分问题行未能写入隔离文件");
+    }
+}
+
+/**
+ * @brief 流式读取学生CSV文件
+ * @details 以STREAM_BUFFER_SIZE为单位分块异步读取文件（io_uring或pread），解析当前块时下一块已在读取，
+ *          逐行解析后交给visitor处理，记录不保存到学生存储
+ *          块末尾不完整的行移到缓冲区开头，与下一块拼接后再解析
+ * @param filename 文件路径
+ * @param visitor 记录处理函数
+ * @param context 传给visitor的上下文
+ * @param projection 列投影，按文件头部定位需要的字段；投影不包含的字段在交给visitor的记录中为空
+ * @param errors 格式错误记录，行号为文件中的行号
+ * @param rows 输出参数，扫描的数据行数
+ * @return 读完整个文件返回true；文件无法打开、读取出错、内存不足或visitor要求停止时返回false
+ * @note 内存占用只与缓冲区大小和最长的行有关，与文件大小无关；课程名称登记到全局课程字典
+ */
+bool streamStudentsFromFile(const char *filename, StudentVisitor visitor, void *context,
+                            LoadProjection projection, CsvErrorLog *errors, int64_t *rows)
+{
+    *rows = 0;
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+        return false;
+
+    // 解析缓冲区之外另有一个读取缓冲区，解析当前块时下一块正在读取
+    size_t capacity = STREAM_BUFFER_SIZE;
+    char *buffer = malloc(capacity);
+    char *incoming = malloc(STREAM_BUFFER_SIZE);
+    CsvLineIndex index;
+    initCsvLineIndex(&index);
+    initCsvScanner();
+    AsyncFile async;
+    openAsyncFile(&async, file);
+
+    size_t used = 0;
+    uint64_t offset = 0;
+    bool headerSkipped = false;
+    CsvProjection columns;
+    bool projected = false;
+    bool ok = buffer != NULL && incoming != NULL && submitAsyncRead(&async, 0, incoming, STREAM_BUFFER_SIZE, 0);
+    while (ok)
+    {
+        int64_t bytesRead = waitAsyncRequest(&async, 0);
+        if (bytesRead < 0)
+        {
+            ok = false;
+            break;
+        }
+        bool atEnd = bytesRead == 0;
+
+        // 读到的数据接在上一块未解析的部分之后；整块只有一行时扩大缓冲区
+        if (used + (size_t)bytesRead > capacity)
+        {
+            size_t grownCapacity = capacity * 2 >= used + (size_t)bytesRead ? capacity * 2 : used + (size_t)bytesRead;
+            char *grown = realloc(buffer, grownCapacity);
+            if (grown == NULL)
+            {
+                ok = false;
+                break;
+            }
+            buffer = grown;
+            capacity = grownCapacity;
+        }
+        memcpy(buffer + used, incoming, (size_t)bytesRead);
+        used += (size_t)bytesRead;
+        offset += (uint64_t)bytesRead;
+        if (!atEnd && !submitAsyncRead(&async, 0, incoming, STREAM_BUFFER_SIZE, offset))
+        {
+            ok = false;
+            break;
+        }
+
+        const char *cursor = buffer;
+        const char *end = buffer + used;
+        while (ok && cursor < end)
+        {
+            const char *nextLine;
+            if (!indexCsvLine(cursor, end, &index, &nextLine))
+            {
+                ok = false;
+                break;
+            }
+
+            // 没有换行符结尾的行可能被块边界截断，文件未读完时留到下一块
+            if (nextLine == end && end[-1] != '\n' && !atEnd)
+                break;
+
+            if (!headerSkipped)
+            {
+                projected = buildCsvProjection(&columns, projection, cursor, &index);
+                headerSkipped = true;
+            }
+            else
+            {
+                (*rows)++;
+                Student student;
+                StudentDetail detail;
+                CsvFieldCursor fields = {cursor, &index, 0, (int)(*rows + 1), errors, 0, 0,
+                                         projected ? &columns : NULL};
+                if (parseStudentLine(&fields, &student, &detail, NULL))
+                    ok = visitor(&student, &detail, context);
+            }
+            cursor = nextLine;
+        }
+
+        if (!ok || atEnd)
+            break;
+
+        // 未解析的部分移到开头
+        used = (size_t)(end - cursor);
+        memmove(buffer, cursor, used);
+    }
+
+    // 释放读取缓冲区之前等待仍在进行的读取
+    closeAsyncFile(&async);
+    freeCsvLineIndex(&index);
+    free(buffer);
+    free(incoming);
+    fclose(file);
+    return ok;
+}
+
+/**
+ * @brief 从保留的CSV文件映射中解码详细信息
+ * @details 重新扫描加载时记下的那一行并解析全部字段，课程名称已在加载时登记，因此得到的课程编号与加载时相同
+ *          列投影不含各科成绩时课程名称在此时才登记
+ * @param source 行相对文件开头的偏移
+ * @param detail 输出参数，解码得到的详细信息
+ * @return 解码成功返回true，偏移无效或内存不足返回false
+ */
+static bool decodeDeferredDetail(uint64_t source, StudentDetail *detail)
+{
+    if (deferredData == NULL || source >= deferredSize)
+        return false;
+
+    const char *line = deferredData + source;
+    const char *nextLine;
+    if (!indexCsvLine(line, deferredData + deferredSize, &deferredIndex, &nextLine))
+        return false;
+
+    // 格式错误在加载时已经报告过
+    CsvErrorLog errors;
+    initCsvErrorLog(&errors);
+    CsvFieldCursor fields = {line, &deferredIndex, 0, 0, &errors, 0, 0, NULL};
+    Student student;
+    return parseStudentLine(&fields, &student, detail, NULL);
+}
+
+/**
+ * @brief 释放延迟加载保留的CSV文件映射
+ * @details 解除映射并取消学生存储中的解码函数，尚未解码的记录之后按空的详细信息处理
+ * @note 需要保留数据时应先调用materializeAllStudents()；在系统退出时调用
+ */
+void releaseDeferredStudentSource()
+{
+    if (deferredData == NULL)
+        return;
+
+    setStudentDetailLoader(NULL);
+    unmapFile(deferredData, deferredSize);
+    freeCsvLineIndex(&deferredIndex);
+    deferredData = NULL;
+    deferredSize = 0;
+}
+
+/**
+ * @brief 获取CSV加载进度
+ * @details 单线程加载每LOAD_PROGRESS_ROWS行更新一次，并行加载时各线程分别累加自己解析过的字节数
+ * @param done 输出参数，已解析的字节数
+ * @param total 输出参数，待解析的总字节数；尚未开始解析CSV（如正在从快照恢复）时为0
+ * @note 可以在其他线程正在执行loadStudentsFromFile()时调用
+ */
+void getStudentLoadProgress(size_t *done, size_t *total)
+{
+    *total = atomic_load(&loadTotalBytes);
+    *done = atomic_load(&loadedBytes);
+    if (*done > *total)
+        *done = *total;
+}
+
+/**
+ * @brief 从CSV文件加载学生数据
+ * @details 将STUDENTS_FILE映射到内存，用向量化扫描器为每行建立字段索引后直接解析，不经过行缓冲区
+ *          解析CSV格式数据，包括学号、姓名、年龄、性别、课程信息等
+ *          大文件按换行符切块后由多个线程并行解析，再按原顺序合并
+ *          如果文件不存在，会初始化为空的学生列表
+ * @note 会跳过CSV文件的头部行，行长度不受限制，同时兼容LF和CRLF换行
+ * @note 学生数组按需扩容，加载完成后收缩到实际记录数，并输出加载吞吐量（MB/s、行/秒）
+ * @note 线程数由--threads=N指定，默认按CPU核数自动选择；加载结果与线程数无关
+ * @note 指定--lazy时只保存统计所需的字段和每条记录的行偏移，文件映射保留到全部记录解码为止，
+ *       姓名和课程明细在显示、修改或导出时才解码
+ * @note 加载完成后会设置statsNeedUpdate标志为true
+ * @note 加载时同时校验数据：UTF-8编码、年龄和性别、课程数量、各科成绩的格式和范围，
+ *       以及总分、平均分与各科成绩是否相符；问题按类别汇总并带行号和列号报告，成绩按0处理，
+ *       不符的总分和平均分按各科成绩重新计算，编码无效的行不加载
+ * @note 存在问题的行原样写入STUDENTS_QUARANTINE_FILE；数据全部正常时不改动该文件
+ * @note 指定--columns=时由头部得出各字段的列号，只解析投影包含的字段（姓名始终跳过），
+ *       跳过的字段在首次访问时解码；只加载统计字段时不交叉校验总分和平均分，课程统计前补齐课程列
+ * @warning 如果CSV格式不正确，可能导致数据解析错误
+ * @see STUDENTS_FILE, STUDENTS_QUARANTINE_FILE, INITIAL_STUDENT_CAPACITY, Student结构体
+ */
+void loadStudentsFromFile()
+{
+    studentCount = 0;
+
+    uint64_t fileSize;
+    if (!getFileInfo(STUDENTS_FILE, &fileSize, NULL))
+    {
+        printInfo("学生数据文件不存在，将创建新文件。");
+        return;
+    }
+    if (fileSize == 0)
+        return;
+
+    double startTime = getCurrentTimeSeconds();
+
+    size_t size;
+    const char *data = mapFile(STUDENTS_FILE, &size);
+    if (data == NULL)
+    {
+        printError("无法读取学生数据文件！");
+        return;
+    }
+
+    const char *end = data + size;
+
+    // 跳过CSV头部
+    const char *cursor = memchr(data, '\n', size);
+    size_t headerLength = cursor != NULL ? (size_t)(cursor - data) : size;
+    if (headerLength > 0 && data[headerLength - 1] == '\r')
+        headerLength--;
+    cursor = cursor != NULL ? cursor + 1 : end;
+    atomic_store(&loadedBytes, 0);
+    atomic_store(&loadTotalBytes, (size_t)(end - cursor));
+
+    // 读取学生数据（扫描内核须在启动加载线程之前选定）
+    initCsvScanner();
+    CsvErrorLog errors;
+    initCsvErrorLog(&errors);
+    QuarantineList quarantine = {NULL, 0, 0, false};
+    const char *base = runtimeOptions.lazyLoad ? data : NULL;
+
+    // 按头部建立列投影，跳过的字段依赖保留的文件映射解码，因此只用于延迟加载
+    CsvProjection columns;
+    const CsvProjection *projection = NULL;
+    if (base != NULL && runtimeOptions.projection != LOAD_COLUMNS_ALL)
+    {
+        CsvLineIndex headerIndex;
+        initCsvLineIndex(&headerIndex);
+        const char *nextLine;
+        if (indexCsvLine(data, end, &headerIndex, &nextLine) &&
+            buildCsvProjection(&columns, runtimeOptions.projection, data, &headerIndex))
+            projection = &columns;
+        else
+            printWarning("学生数据文件头部缺少列投影需要的列，将解析全部字段");
+        freeCsvLineIndex(&headerIndex);
+    }
+
+    int threads = chooseLoadThreads((size_t)(end - cursor));
+    int rows = threads > 1 ? loadStudentsParallel(base, cursor, end, threads, projection, &errors, &quarantine) : -1;
+    if (rows < 0)
+    {
+        threads = 1;
+        rows = loadStudentsSequential(base, cursor, end, projection, &errors, &quarantine);
+    }
+
+    // 只加载统计字段时课程列为空，课程统计之前再解码补齐
+    if (projection != NULL && projection->mode == LOAD_COLUMNS_AGGREGATES)
+        markCourseColumnsPending();
+
+    // 问题行指向映射的文件，须在解除映射之前写出
+    bool quarantined = quarantine.count > 0 && writeQuarantineFile(data, headerLength, &quarantine);
+    
+    if (base != NULL)
+    {
+        // 延迟加载：保留映射，详细信息在首次访问时从中解码
+        deferredData = data;
+        deferredSize = size;
+        initCsvLineIndex(&deferredIndex);
+        setStudentDetailLoader(decodeDeferredDetail);
+    }
+    else
+    {
+        unmapFile(data, size);
+    }
+
+    atomic_store(&loadedBytes, (size_t)(end - cursor));
+
+    // 释放倍增扩容留下的多余容量
+    shrinkStudentStore();
+    
+    // 更新统计信息
+    statsNeedUpdate = true;
+    
+    // 使统计缓存无效
+    invalidateCache();
+
+    reportLoadThroughput(size, rows, threads, getCurrentTimeSeconds() - startTime);
+    reportParseErrors(&errors, &quarantine, quarantined);
+    freeQuarantineList(&quarantine);
+}
+
+/**
+ * @brief 从CSV数据区间加载学生记录
+ * @details 逐行解析[start, end)中的数据行并追加到学生存储，与loadStudentsFromFile()的单线程解析规则相同
+ * @param start 区间起始位置（行首）
+ * @param end 区间结束位置（行首或数据末尾）
+ * @return 追加的学生数
+ * @note 用于快照损坏时只重新解析受影响的行；数据问题在首次导入时已经报告，这里不再输出
+ */
+int loadStudentsFromRange(const char *start, const char *end)
+{
+    CsvErrorLog errors;
+    initCsvErrorLog(&errors);
+    QuarantineList quarantine = {NULL, 0, 0, false};
+
+    int before = studentCount;
+    loadStudentsSequential(NULL, start, end, NULL, &errors, &quarantine);
+    freeQuarantineList(&quarantine);
+    return studentCount - before;
+}
+
+/**
+ * @brief 向记录缓冲区追加一段文本
+ * @param buffer 缓冲区
+ * @param size 缓冲区大小
+ * @param length 输入输出参数，已写入的长度
+ * @param text 文本
+ * @param textLength 文本字节数
+ * @return 写得下返回true，缓冲区不足返回false
+ */
+static inline bool appendRecordBytes(char *buffer, size_t size, size_t *length, const char *text, size_t textLength)
+{
+    if (textLength >= size - *length)
+        return false;
+    memcpy(buffer + *length, text, textLength);
+    *length += textLength;
+    return true;
+}
+
+/**
+ * @brief 向记录缓冲区追加一个非负整数
+ * @param buffer 缓冲区
+ * @param size 缓冲区大小
+ * @param length 输入输出参数，已写入的长度
+ * @param value 整数（年龄、课程数量等，负数按0输出）
+ * @return 写得下返回true，缓冲区不足返回false
+ */
+static inline bool appendRecordInt(char *buffer, size_t size, size_t *length, int value)
+{
+    // 逆序生成后再正序写出
+    char digits[10];
+    int n = 0;
+    unsigned int magnitude = value > 0 ? (unsigned int)value : 0u;
+    do
+    {
+        digits[n++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if ((size_t)n >= size - *length)
+        return false;
+    while (n > 0)
+    {
+        buffer[(*length)++] = digits[--n];
+    }
+    return true;
+}
+
+/**
+ * @brief 向记录缓冲区追加一个定点成绩
+ * @param buffer 缓冲区
+ * @param size 缓冲区大小
+ * @param length 输入输出参数，已写入的长度
+ * @param score 定点成绩
+ * @return 写得下返回true，缓冲区不足返回false
+ */
+static inline bool appendRecordScore(char *buffer, size_t size, size_t *length, int32_t score)
+{
+    // formatScore()直接写入缓冲区，需要留出SCORE_TEXT_SIZE的空间
+    if (SCORE_TEXT_SIZE > size - *length)
+        return false;
+    *length += (size_t)formatScore(buffer + *length, score);
+    return true;
+}
+
+/**
+ * @brief 把一条学生记录格式化为CSV数据行
+ * @details 格式与STUDENTS_FILE中的数据行相同：学号、姓名、年龄、性别、课程数量、
+ *          MAX_COURSES组课程名称和成绩（不足的用空值填充）、总分、平均分
+ * @param buffer 输出缓冲区，长度至少为STUDENT_RECORD_TEXT_SIZE
+ * @param size 缓冲区大小
+ * @param student 学生记录
+ * @param detail 学生详细信息
+ * @return 数据行长度（不含换行符），缓冲区不足时返回0
+ * @note 逐字段直接复制和转换数字，不经过printf系列函数；成绩使用整数格式化，不经过浮点数
+ */
+size_t formatStudentRecord(char *buffer, size_t size, const Student *student, const StudentDetail *detail)
+{
+    size_t length = 0;
+    char genderField[3] = {',', student->gender, ','};
+
+    // 基本信息
+    if (!appendRecordBytes(buffer, size, &length, student->studentID, strlen(student->studentID)) ||
+        !appendRecordBytes(buffer, size, &length, ",", 1) ||
+        !appendRecordBytes(buffer, size, &length, detail->name, strlen(detail->name)) ||
+        !appendRecordBytes(buffer, size, &length, ",", 1) ||
+        !appendRecordInt(buffer, size, &length, student->age) ||
+        !appendRecordBytes(buffer, size, &length, genderField, 3) ||
+        !appendRecordInt(buffer, size, &length, detail->courseCount))
+        return 0;
+
+    // 课程和成绩
+    for (int j = 0; j < detail->courseCount; j++)
+    {
+        const char *courseName = getCourseName(detail->courseIds[j]);
+        if (!appendRecordBytes(buffer, size, &length, ",", 1) ||
+            !appendRecordBytes(buffer, size, &length, courseName, strlen(courseName)) ||
+            !appendRecordBytes(buffer, size, &length, ",", 1) ||
+            !appendRecordScore(buffer, size, &length, detail->scores[j]))
+            return 0;
+    }
+    for (int j = detail->courseCount; j < MAX_COURSES; j++)
+    {
+        if (!appendRecordBytes(buffer, size, &length, ",,", 2)) // 空的课程和成绩
+            return 0;
+    }
+
+    // 总分和平均分
+    if (!appendRecordBytes(buffer, size, &length, ",", 1) ||
+        !appendRecordScore(buffer, size, &length, student->totalScore) ||
+        !appendRecordBytes(buffer, size, &length, ",", 1) ||
+        !appendRecordScore(buffer, size, &length, student->averageScore))
+        return 0;
+    return length;
+}
+
+/**
+ * @brief 把连续的多条学生记录格式化到写入缓冲区
+ * @details 从第*index条开始逐行格式化，每行后加换行符，直到缓冲区剩余空间不足一行或到达end
+ * @param buffer 写入缓冲区
+ * @param size 缓冲区大小，至少为STUDENT_RECORD_TEXT_SIZE + 1
+ * @param index 输入输出参数，下一条要格式化的学生下标
+ * @param end 最后一条学生下标（不包含）
+ * @return 写入缓冲区的字节数
+ */
+static size_t formatStudentRows(char *buffer, size_t size, int *index, int end)
+{
+    size_t length = 0;
+    int i = *index;
+    while (i < end && size - length > STUDENT_RECORD_TEXT_SIZE)
+    {
+        length += formatStudentRecord(buffer + length, STUDENT_RECORD_TEXT_SIZE, &students[i], getStudentDetail(&students[i]));
+        buffer[length++] = '\n';
+        i++;
+    }
+    *index = i;
+    return length;
+}
+
+/**
+ * @brief 解析一条CSV数据行
+ * @details 与加载STUDENTS_FILE时的解析规则相同，课程名称登记到全局课程字典
+ * @param line 数据行起始位置
+ * @param length 数据行长度（不含换行符）
+ * @param student 输出参数，学生记录（idKey和handle不填写）
+ * @param detail 输出参数，学生详细信息
+ * @return 解析成功返回true；编码无效、字段不足或内存不足时返回false
+ * @note 用于重放变更日志；总分、平均分与各科成绩不符时与加载时一样按各科成绩重新计算
+ */
+bool parseStudentRecord(const char *line, size_t length, Student *student, StudentDetail *detail)
+{
+    if (!validateUtf8(line, length))
+        return false;
+
+    CsvLineIndex index;
+    initCsvLineIndex(&index);
+    CsvErrorLog errors;
+    initCsvErrorLog(&errors);
+
+    bool parsed = false;
+    const char *nextLine;
+    if (indexCsvLine(line, line + length, &index, &nextLine))
+    {
+        CsvFieldCursor fields = {line, &index, 0, 0, &errors, 0, 0, NULL};
+        parsed = parseStudentLine(&fields, student, detail, NULL);
+    }
+
+    freeCsvLineIndex(&index);
+    return parsed;
+}
+
+/**
+ * @brief 格式化一个保存数据块
+ * @details 把数据块中的记录逐行格式化到块自己的缓冲区，剩余空间不足一行时扩容
+ * @param block 数据块
+ */
+static void formatSaveBlock(SaveBlock *block)
+{
+    block->length = 0;
+    int index = block->start;
+    while (index < block->end)
+    {
+        if (block->capacity - block->length <= STUDENT_RECORD_TEXT_SIZE)
+        {
+            size_t capacity = block->capacity > 0 ? block->capacity * 2 : CSV_WRITE_BUFFER_SIZE;
+            char *grown = realloc(block->buffer, capacity);
+            if (grown == NULL)
+            {
+                block->outOfMemory = true;
+                return;
+            }
+            block->buffer = grown;
+            block->capacity = capacity;
+        }
+        block->length += formatStudentRows(block->buffer + block->length, block->capacity - block->length,
+                                           &index, block->end);
+    }
+}
+
+/**
+ * @brief 格式化本轮的数据块
+ * @details 从工作队列中依次领取数据块并格式化，直到本轮所有数据块都被领取
+ * @param pool 工作队列
+ */
+static void formatSaveBlocks(SavePool *pool)
+{
+    int index;
+    while ((index = atomic_fetch_add(&pool->nextBlock, 1)) < pool->blockCount)
+    {
+        formatSaveBlock(&pool->blocks[index]);
+    }
+}
+
+#ifndef _WIN32
+/**
+ * @brief 保存线程入口
+ * @details 等待当前线程发布新一轮数据块，参与格式化后报告完成，直到保存结束
+ * @param arg 工作队列（SavePool）
+ * @return 总是返回NULL
+ */
+static void *saveWorker(void *arg)
+{
+    SavePool *pool = arg;
+    int finishedRound = 0;
+
+    pthread_mutex_lock(&pool->mutex);
+    while (true)
+    {
+        while (pool->round == finishedRound && !pool->stopping)
+        {
+            pthread_cond_wait(&pool->roundReady, &pool->mutex);
+        }
+        if (pool->stopping)
+            break;
+        finishedRound = pool->round;
+        pthread_mutex_unlock(&pool->mutex);
+
+        formatSaveBlocks(pool);
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->busyWorkers == 0)
+            pthread_cond_signal(&pool->roundDone);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+#endif
+
+/**
+ * @brief 并行格式化一轮数据块
+ * @details 发布本轮的数据块并唤醒工作线程，当前线程也参与领取，返回前等待所有工作线程完成本轮
+ * @param pool 工作队列
+ * @param blocks 本轮的数据块
+ * @param blockCount 数据块数量
+ */
+static void formatSaveRound(SavePool *pool, SaveBlock *blocks, int blockCount)
+{
+#ifndef _WIN32
+    pthread_mutex_lock(&pool->mutex);
+#endif
+    pool->blocks = blocks;
+    pool->blockCount = blockCount;
+    atomic_store(&pool->nextBlock, 0);
+#ifndef _WIN32
+    pool->busyWorkers = pool->workerCount;
+    pool->round++;
+    pthread_cond_broadcast(&pool->roundReady);
+    pthread_mutex_unlock(&pool->mutex);
+#endif
+
+    formatSaveBlocks(pool);
+
+#ifndef _WIN32
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->busyWorkers > 0)
+    {
+        pthread_cond_wait(&pool->roundDone, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+#endif
+}
+
+/**
+ * @brief 保存学生数据行
+ * @details 每轮把接下来的threadCount * SAVE_BLOCK_ROWS条记录切分为threadCount个连续的数据块，
+ *          由线程池并行格式化到各块自己的缓冲区，再按记录顺序作为一个写入请求异步提交；
+ *          ASYNC_IO_SLOTS组数据块轮流使用，上一轮写入期间即可格式化下一轮；
+ *          工作线程在开始时创建、结束时回收，各轮之间通过条件变量唤醒，不重复创建线程
+ * @param async 异步写入的文件
+ * @param offset 第一行数据的文件偏移（CSV头部之后）
+ * @param threadCount 线程数（包括当前线程）
+ * @param bytes 输入输出参数，累加写入的字节数
+ * @return 全部写入返回true；内存不足或写入失败返回false
+ * @note 各块按记录顺序首尾相接，输出与线程数无关
+ */
+static bool saveStudentRows(AsyncFile *async, uint64_t offset, int threadCount, size_t *bytes)
+{
+    SaveBlock *blocks = calloc((size_t)(ASYNC_IO_SLOTS * threadCount), sizeof(SaveBlock));
+    char **buffers = malloc((size_t)threadCount * sizeof(char *));
+    size_t *lengths = malloc((size_t)threadCount * sizeof(size_t));
+    bool ok = blocks != NULL && buffers != NULL && lengths != NULL;
+
+    SavePool pool;
+    atomic_init(&pool.nextBlock, 0);
+#ifndef _WIN32
+    pthread_mutex_init(&pool.mutex, NULL);
+    pthread_cond_init(&pool.roundReady, NULL);
+    pthread_cond_init(&pool.roundDone, NULL);
+    pool.round = 0;
+    pool.busyWorkers = 0;
+    pool.stopping = false;
+
+    // 线程创建失败时由其余线程（至少有当前线程）完成全部数据块
+    pthread_t threads[MAX_LOAD_THREADS];
+    int started = 0;
+    for (int i = 1; ok && i < threadCount; i++)
+    {
+        if (pthread_create(&threads[started], NULL, saveWorker, &pool) == 0)
+            started++;
+    }
+    pool.workerCount = started;
+#endif
+
+    int next = 0;
+    for (int round = 0; ok && next < studentCount; round++)
+    {
+        // 这组缓冲区上次提交的写入完成后才能复用
+        int slot = round % ASYNC_IO_SLOTS;
+        SaveBlock *group = blocks + slot * threadCount;
+        if (waitAsyncRequest(async, slot) < 0)
+        {
+            ok = false;
+            break;
+        }
+
+        int blockCount = 0;
+        while (blockCount < threadCount && next < studentCount)
+        {
+            group[blockCount].start = next;
+            next = studentCount - next > SAVE_BLOCK_ROWS ? next + SAVE_BLOCK_ROWS : studentCount;
+            group[blockCount].end = next;
+            blockCount++;
+        }
+
+        formatSaveRound(&pool, group, blockCount);
+
+        size_t roundBytes = 0;
+        for (int i = 0; i < blockCount; i++)
+        {
+            ok = ok && !group[i].outOfMemory;
+            buffers[i] = group[i].buffer;
+            lengths[i] = group[i].length;
+            roundBytes += group[i].length;
+        }
+        ok = ok && submitAsyncWrite(async, slot, buffers, lengths, blockCount, offset);
+        offset += roundBytes;
+        *bytes += roundBytes;
+    }
+
+#ifndef _WIN32
+    pthread_mutex_lock(&pool.mutex);
+    pool.stopping = true;
+    pthread_cond_broadcast(&pool.roundReady);
+    pthread_mutex_unlock(&pool.mutex);
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_cond_destroy(&pool.roundDone);
+    pthread_cond_destroy(&pool.roundReady);
+    pthread_mutex_destroy(&pool.mutex);
+#endif
+
+    // 释放缓冲区之前等待全部写入完成
+    for (int slot = 0; slot < ASYNC_IO_SLOTS; slot++)
+    {
+        if (waitAsyncRequest(async, slot) < 0)
+            ok = false;
+    }
+
+    if (blocks != NULL)
+    {
+        for (int i = 0; i < ASYNC_IO_SLOTS * threadCount; i++)
+        {
+            free(blocks[i].buffer);
+        }
+    }
+    free(blocks);
+    free(buffers);
+    free(lengths);
+    return ok;
+}
+
+/**
+ * @brief 确定保存线程数
+ * @details 使用--threads=N指定的线程数；未指定时按CPU核数自动选择，
+ *          但少于PARALLEL_SAVE_MIN_ROWS条记录时单线程保存，避免创建线程的开销超过收益
+ * @return 线程数（1到MAX_LOAD_THREADS）
+ */
+static int chooseSaveThreads()
+{
+#ifdef _WIN32
+    // Windows下没有pthread，始终单线程保存
+    return 1;
+#else
+    if (runtimeOptions.loadThreads > 0)
+        return runtimeOptions.loadThreads;
+
+    if (studentCount < PARALLEL_SAVE_MIN_ROWS)
+        return 1;
+
+    int threads = getProcessorCount();
+    return threads < MAX_LOAD_THREADS ? threads : MAX_LOAD_THREADS;
+#endif
+}
+
+/**
+ * @brief 输出保存吞吐量
+ * @param bytes 写入的字节数
+ * @param threads 保存线程数
+ * @param backend 异步写入的后端名称
+ * @param seconds 耗时（秒），包括fsync和重命名
+ */
+static void reportSaveThroughput(size_t bytes, int threads, const char *backend, double seconds)
+{
+    // 计时精度不足时按1微秒计算，避免除零
+    if (seconds < 1e-6)
+        seconds = 1e-6;
+
+    double megabytes = (double)bytes / (1024.0 * 1024.0);
+    fprintf(messageStream(), "已保存 %d 名学生（%.2f MB，%d 线程，%s写入），耗时 %.3f 秒，%.1f MB/s，%.0f 行/秒\n",
+            studentCount, megabytes, threads, backend, seconds, megabytes / seconds, studentCount / seconds);
+}
+
+/**
+ * @brief 将学生数据保存到CSV文件
+ * @details 将内存中的所有学生数据以CSV格式保存到STUDENTS_FILE文件中
+ *          包含完整的CSV头部和所有学生的详细信息
+ *          保存成功后会重置dataModified标志
+ * @note CSV格式包括：学号、姓名、年龄、性别、课程数量、各课程名称和成绩、总分、平均分
+ * @note 对于课程数量不足MAX_COURSES的学生，会用空值填充
+ * @note 按SAVE_BLOCK_ROWS行分块格式化到内存缓冲区，整块异步写入（io_uring或pwrite），
+ *       写入上一块时格式化下一块；记录较多时由多个线程并行格式化，输出与单线程保存完全相同
+ * @note 延迟加载的记录会先全部解码，再覆盖写入其所在的CSV文件
+ * @note 先写入同一目录的临时文件，fsync后重命名替换STUDENTS_FILE，保存中途崩溃时原文件保持完整
+ * @note 保存成功后清空变更日志STUDENTS_JOURNAL_FILE
+ * @warning 如果文件无法创建或写入，会显示错误信息
+ * @see STUDENTS_FILE, MAX_COURSES, dataModified
+ */
+void saveStudentsToFile()
+{
+    // 覆盖写入前解除对旧文件内容的依赖，否则截断文件后映射失效
+    if (!materializeAllStudents())
+    {
+        printError("内存不足，无法保存学生数据！");
+        return;
+    }
+    releaseDeferredStudentSource();
+
+    AtomicFile atomic;
+    FILE *file = openAtomicFile(&atomic, STUDENTS_FILE, "w");
+    if (file == NULL)
+    {
+        printError("无法保存学生数据！");
+        return;
+    }
+    double startTime = getCurrentTimeSeconds();
+
+    // CSV头部
+    char header[STUDENT_RECORD_TEXT_SIZE];
+    size_t length = (size_t)snprintf(header, sizeof(header), "学号,姓名,年龄,性别,课程数量");
+    for (int i = 0; i < MAX_COURSES; i++)
+    {
+        length += (size_t)snprintf(header + length, sizeof(header) - length, ",课程%d,成绩%d", i + 1, i + 1);
+    }
+    length += (size_t)snprintf(header + length, sizeof(header) - length, ",总分,平均分\n");
+
+    // 头部和数据行都按偏移异步写入，格式化下一块时上一块正在写入
+    AsyncFile async;
+    openAsyncFile(&async, file);
+    char *headerBuffer = header;
+    size_t bytes = length;
+    int threads = chooseSaveThreads();
+    bool written = submitAsyncWrite(&async, 0, &headerBuffer, &length, 1, 0) &&
+                   saveStudentRows(&async, length, threads, &bytes);
+    const char *backend = getAsyncFileBackend(&async);
+    closeAsyncFile(&async);
+
+    if (!written)
+    {
+        abortAtomicFile(&atomic);
+        printError("无法保存学生数据！");
+        return;
+    }
+    if (!commitAtomicFile(&atomic, true))
+    {
+        printError("无法保存学生数据！");
+        return;
+    }
+    dataModified = false;
+    reportSaveThroughput(bytes, threads, backend, getCurrentTimeSeconds() - startTime);
+
+    // CSV文件已包含全部变更，变更日志随之清空
+    resetStudentJournal();
 
     printSuccess("学生数据已保存到CSV文件！");
 }
\ No newline at end of file
@@ -0,0 +1,601 @@
+/**
+ * @file student_journal.c
+ * @brief 学生数据变更日志实现
+ * @note 每条记录占一行：记录类型、CRC32C（8位十六进制）和记录内容，以逗号分隔
+ *       新增或修改的记录内容为完整的CSV数据行，删除的记录内容为学号
+ *       变更先登记到待写入列表，由后台自动保存线程定时或攒够一定数量后批量写入并fsync，
+ *       交互菜单不必等待磁盘；同一学生在两次写入之间的多次修改只写入最终内容
+ *       没有自动保存线程时（--autosave=0或Windows），记录写入后立即刷新到操作系统，
+ *       fsync按批量进行，距上次同步较久时立即同步
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+#include "config.h"
+#include "globals.h"
+#include "io_utils.h"
+#include "file_utils.h"
+#include "system_utils.h"
+#include "student_io.h"
+#include "student_store.h"
+#include "student_id.h"
+#include "crc32c.h"
+#include "student_journal.h"
+
+// 记录内容之前的部分：记录类型、逗号、8位十六进制CRC32C、逗号
+#define JOURNAL_PREFIX_LENGTH 11
+
+#ifndef _WIN32
+/**
+ * @brief 待写入的变更
+ * @details 交互线程记录变更时先把数据行复制到这里，由自动保存线程写入日志
+ */
+typedef struct {
+    char type;                          // 记录类型
+    char studentID[MAX_ID_LENGTH];      // 学号，用于合并同一学生的多次修改
+    size_t length;                      // 记录内容字节数
+    char text[STUDENT_RECORD_TEXT_SIZE]; // 记录内容
+} PendingRecord;
+#endif
+
+// 以下状态在自动保存线程运行期间只由该线程访问，线程结束后由交互线程访问
+static FILE *journalFile = NULL;        // 追加写入的日志文件，首次记录变更时打开
+static int journalRecords = 0;          // 日志中的记录数（包括启动时重放的记录）
+static int unsyncedRecords = 0;         // 已写入但尚未fsync的记录数
+static double lastSyncTime = 0.0;       // 上次fsync的时间
+
+static bool journalDisabled = false;    // 日志写入失败，之后的变更改为退出时完整保存（交互线程）
+
+#ifndef _WIN32
+// 自动保存线程状态，待写入列表和autosaveFailed受autosaveMutex保护
+static pthread_t autosaveThread;
+static pthread_mutex_t autosaveMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t autosaveWake = PTHREAD_COND_INITIALIZER;
+static bool autosaveRunning = false;    // 线程已启动且尚未回收
+static bool autosaveStopping = false;   // 已请求停止，之后不再启动线程
+static bool autosaveFailed = false;     // 后台写入日志失败
+static PendingRecord *pendingRecords = NULL; // 待写入的变更，按登记顺序排列
+static int pendingCount = 0;
+static int pendingCapacity = 0;
+#endif
+
+/**
+ * @brief 计算一条记录的校验和
+ * @param type 记录类型
+ * @param payload 记录内容
+ * @param length 记录内容字节数
+ * @return 覆盖记录类型和内容的CRC32C
+ */
+static uint32_t journalRecordChecksum(char type, const char *payload, size_t length)
+{
+    return crc32c(crc32c(0, &type, 1), payload, length);
+}
+
+/**
+ * @brief 解析8位十六进制校验和
+ * @param text 文本起始位置
+ * @param value 输出参数，校验和
+ * @return 格式正确返回true
+ */
+static bool parseJournalChecksum(const char *text, uint32_t *value)
+{
+    uint32_t result = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        char c = text[i];
+        uint32_t digit;
+        if (c >= '0' && c <= '9')
+            digit = (uint32_t)(c - '0');
+        else if (c >= 'a' && c <= 'f')
+            digit = (uint32_t)(c - 'a' + 10);
+        else
+            return false;
+        result = (result << 4) | digit;
+    }
+    *value = result;
+    return true;
+}
+
+/**
+ * @brief 在学生数组中查找学号
+ * @param studentID 学号
+ * @return 学生下标，不存在时返回-1
+ */
+static int findJournalStudent(const char *studentID)
+{
+    uint64_t key = encodeStudentID(studentID);
+    for (int i = 0; i < studentCount; i++)
+    {
+        if (compareStudentID(students[i].idKey, students[i].studentID, key, studentID) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief 应用一条新增或修改记录
+ * @param payload CSV数据行
+ * @param length 数据行长度
+ * @return 成功返回true；数据行无法解析或内存不足时返回false
+ */
+static bool replayUpsert(const char *payload, size_t length)
+{
+    Student student;
+    StudentDetail detail;
+    if (!parseStudentRecord(payload, length, &student, &detail))
+        return false;
+
+    int index = findJournalStudent(student.studentID);
+    if (index < 0)
+        return appendStudent(&student, &detail) != NULL;
+
+    // 原地覆盖，保留学号编码键和句柄
+    StudentDetail *target = getStudentDetail(&students[index]);
+    student.idKey = students[index].idKey;
+    student.handle = students[index].handle;
+    students[index] = student;
+    *target = detail;
+    syncStudentColumns(index);
+    return true;
+}
+
+/**
+ * @brief 应用一条删除记录
+ * @param payload 学号
+ * @param length 学号长度
+ * @return 成功返回true（学号不存在也视为成功），学号过长时返回false
+ */
+static bool replayDelete(const char *payload, size_t length)
+{
+    if (length == 0 || length >= MAX_ID_LENGTH)
+        return false;
+
+    char studentID[MAX_ID_LENGTH];
+    memcpy(studentID, payload, length);
+    studentID[length] = '\0';
+
+    int index = findJournalStudent(studentID);
+    if (index >= 0)
+        removeStudentAt(index);
+    return true;
+}
+
+/**
+ * @brief 重放变更日志
+ * @details 读取STUDENTS_JOURNAL_FILE，校验每条记录的CRC32C后依次应用到学生存储：
+ *          新增或修改按学号覆盖已有记录（不存在时追加），删除按学号移除
+ * @note 应在学生数据从CSV文件或快照加载完成后、初始化统计缓存之前调用
+ * @note 末尾不完整或校验失败的记录（如写入时断电）被丢弃，并把日志截断到最后一条完整记录
+ * @note 记录按学号覆盖或删除，同一日志重放多次的结果相同，因此CSV保存后、清空日志前中断也不会出错
+ */
+void replayStudentJournal()
+{
+    size_t size;
+    const char *data = mapFile(STUDENTS_JOURNAL_FILE, &size);
+    if (data == NULL)
+        return;
+
+    initCrc32c();
+    int upserts = 0;
+    int deletes = 0;
+    int skipped = 0;
+
+    const char *cursor = data;
+    const char *end = data + size;
+    while (cursor < end)
+    {
+        const char *newline = memchr(cursor, '\n', (size_t)(end - cursor));
+        if (newline == NULL || newline - cursor < JOURNAL_PREFIX_LENGTH)
+            break;
+
+        char type = cursor[0];
+        uint32_t checksum;
+        const char *payload = cursor + JOURNAL_PREFIX_LENGTH;
+        size_t length = (size_t)(newline - payload);
+        if ((type != JOURNAL_RECORD_UPSERT && type != JOURNAL_RECORD_DELETE) ||
+            cursor[1] != ',' || cursor[JOURNAL_PREFIX_LENGTH - 1] != ',' ||
+            !parseJournalChecksum(cursor + 2, &checksum) ||
+            checksum != journalRecordChecksum(type, payload, length))
+            break;
+
+        bool applied = type == JOURNAL_RECORD_UPSERT ? replayUpsert(payload, length) : replayDelete(payload, length);
+        if (!applied)
+            skipped++;
+        else if (type == JOURNAL_RECORD_UPSERT)
+            upserts++;
+        else
+            deletes++;
+
+        journalRecords++;
+        cursor = newline + 1;
+    }
+
+    size_t validSize = (size_t)(cursor - data);
+    unmapFile(data, size);
+
+    if (journalRecords > 0)
+    {
+        printInfo("已重放学生数据变更日志");
+        fprintf(messageStream(), "  新增或修改：%d 条，删除：%d 条\n", upserts, deletes);
+    }
+    if (skipped > 0)
+    {
+        printWarning("变更日志中有记录无法应用（格式错误或内存不足），已跳过");
+        fprintf(messageStream(), "  跳过的记录：%d 条\n", skipped);
+    }
+    if (validSize < size)
+    {
+        // 截断后新记录才能接在最后一条完整记录之后
+        printWarning("变更日志末尾的记录不完整或已损坏，已丢弃");
+        fprintf(messageStream(), "  丢弃的字节数：%llu\n", (unsigned long long)(size - validSize));
+        if (!truncateFile(STUDENTS_JOURNAL_FILE, validSize))
+        {
+            printWarning("无法截断变更日志，退出时将完整保存学生数据");
+            dataModified = true;
+        }
+    }
+}
+
+/**
+ * @brief 处理日志写入失败
+ * @details 输出警告并改为在退出时完整保存CSV文件，之后的变更不再写入日志
+ * @note 只在交互线程调用；后台线程写入失败时先记下，由交互线程在下次记录变更或退出时处理
+ */
+static void journalWriteFailed()
+{
+    if (!journalDisabled)
+    {
+        printWarning("无法写入变更日志，退出时将完整保存学生数据");
+    }
+    journalDisabled = true;
+    dataModified = true;
+}
+
+/**
+ * @brief 写入一条日志记录
+ * @details 写入后立即刷新到操作系统，不调用fsync
+ * @param type 记录类型
+ * @param payload 记录内容（不含换行符）
+ * @param length 记录内容字节数
+ * @return 成功返回true，文件无法打开或写入时返回false
+ */
+static bool writeJournalRecord(char type, const char *payload, size_t length)
+{
+    if (journalFile == NULL)
+    {
+        journalFile = fopen(STUDENTS_JOURNAL_FILE, "ab");
+        if (journalFile == NULL)
+            return false;
+        initCrc32c();
+    }
+
+    uint32_t checksum = journalRecordChecksum(type, payload, length);
+    fprintf(journalFile, "%c,%08lx,", type, (unsigned long)checksum);
+    fwrite(payload, 1, length, journalFile);
+    fputc('\n', journalFile);
+    if (fflush(journalFile) != 0 || ferror(journalFile))
+        return false;
+
+    journalRecords++;
+    unsyncedRecords++;
+    return true;
+}
+
+/**
+ * @brief 追加一条日志记录
+ * @details 没有后台自动保存线程时使用：写入后立即刷新到操作系统；
+ *          未同步的记录达到JOURNAL_SYNC_RECORDS条，或距上次同步超过JOURNAL_SYNC_INTERVAL_MS时调用fsync
+ * @param type 记录类型
+ * @param payload 记录内容（不含换行符）
+ * @param length 记录内容字节数
+ * @return 成功返回true，文件无法打开或写入时返回false
+ */
+static bool appendJournalRecord(char type, const char *payload, size_t length)
+{
+    if (!writeJournalRecord(type, payload, length))
+        return false;
+
+    double now = getCurrentTimeSeconds();
+    if (unsyncedRecords >= JOURNAL_SYNC_RECORDS || (now - lastSyncTime) * 1000.0 >= JOURNAL_SYNC_INTERVAL_MS)
+        return syncStudentJournal();
+    return true;
+}
+
+#ifndef _WIN32
+/**
+ * @brief 登记一条待写入的变更
+ * @details 同一学生最近一条待写入的变更是新增或修改时，直接用新内容覆盖它（删除也覆盖为删除），
+ *          否则追加到末尾；因此一个学生在两次写入之间无论修改多少次，都只写入最终内容
+ * @param type 记录类型
+ * @param studentID 学号
+ * @param text 记录内容
+ * @param length 记录内容字节数
+ * @return 成功返回true，内存不足返回false
+ * @note 调用者必须持有autosaveMutex
+ */
+static bool addPendingRecord(char type, const char *studentID, const char *text, size_t length)
+{
+    PendingRecord *record = NULL;
+    for (int i = pendingCount - 1; i >= 0; i--)
+    {
+        if (strcmp(pendingRecords[i].studentID, studentID) == 0)
+        {
+            // 删除之后再新增的学生是新的记录，保持先删除后新增的顺序
+            if (pendingRecords[i].type == JOURNAL_RECORD_UPSERT)
+                record = &pendingRecords[i];
+            break;
+        }
+    }
+
+    if (record == NULL)
+    {
+        if (pendingCount == pendingCapacity)
+        {
+            int capacity = pendingCapacity > 0 ? pendingCapacity * 2 : AUTOSAVE_CHANGES;
+            PendingRecord *grown = realloc(pendingRecords, (size_t)capacity * sizeof(PendingRecord));
+            if (grown == NULL)
+                return false;
+            pendingRecords = grown;
+            pendingCapacity = capacity;
+        }
+        record = &pendingRecords[pendingCount++];
+        strcpy(record->studentID, studentID);
+    }
+
+    record->type = type;
+    record->length = length;
+    memcpy(record->text, text, length);
+    return true;
+}
+
+/**
+ * @brief 写入一批待写入的变更
+ * @details 依次写入日志后调用一次fsync
+ * @param records 待写入的变更
+ * @param count 变更数
+ * @return 全部写入并同步成功返回true
+ */
+static bool writePendingRecords(const PendingRecord *records, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (!writeJournalRecord(records[i].type, records[i].text, records[i].length))
+            return false;
+    }
+    return syncStudentJournal();
+}
+
+/**
+ * @brief 自动保存线程入口
+ * @details 每隔runtimeOptions.autosaveIntervalMs，或待写入的变更达到runtimeOptions.autosaveChanges条时被唤醒，
+ *          取走全部待写入的变更后释放锁再写入日志，交互线程记录变更时不必等待磁盘
+ * @param arg 未使用
+ * @return 总是返回NULL
+ * @note 收到停止请求时写完剩余的变更再退出
+ */
+static void *autosaveMain(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&autosaveMutex);
+    while (true)
+    {
+        if (!autosaveStopping && pendingCount < runtimeOptions.autosaveChanges)
+        {
+            struct timespec deadline;
+            timespec_get(&deadline, TIME_UTC);
+            long long nanoseconds = deadline.tv_nsec + (long long)runtimeOptions.autosaveIntervalMs * 1000000LL;
+            deadline.tv_sec += (time_t)(nanoseconds / 1000000000LL);
+            deadline.tv_nsec = (long)(nanoseconds % 1000000000LL);
+            pthread_cond_timedwait(&autosaveWake, &autosaveMutex, &deadline);
+        }
+
+        if (pendingCount > 0 && !autosaveFailed)
+        {
+            // 取走当前的待写入变更，写入期间交互线程可以继续登记新的变更
+            PendingRecord *records = pendingRecords;
+            int count = pendingCount;
+            pendingRecords = NULL;
+            pendingCount = 0;
+            pendingCapacity = 0;
+            pthread_mutex_unlock(&autosaveMutex);
+
+            bool written = writePendingRecords(records, count);
+            free(records);
+
+            pthread_mutex_lock(&autosaveMutex);
+            if (!written)
+                autosaveFailed = true;
+        }
+
+        if (autosaveStopping && (pendingCount == 0 || autosaveFailed))
+            break;
+    }
+    pthread_mutex_unlock(&autosaveMutex);
+    return NULL;
+}
+
+/**
+ * @brief 确保自动保存线程已启动
+ * @return 线程正在运行返回true；自动保存已关闭、已停止或线程无法创建时返回false
+ */
+static bool startAutosave()
+{
+    if (autosaveRunning)
+        return true;
+    if (runtimeOptions.autosaveIntervalMs <= 0 || autosaveStopping)
+        return false;
+
+    autosaveRunning = pthread_create(&autosaveThread, NULL, autosaveMain, NULL) == 0;
+    return autosaveRunning;
+}
+#endif
+
+/**
+ * @brief 记录一条变更
+ * @details 自动保存线程运行时只登记到待写入列表，由后台线程写入；否则直接追加到日志
+ * @param type 记录类型
+ * @param studentID 学号
+ * @param text 记录内容
+ * @param length 记录内容字节数
+ */
+static void recordJournalChange(char type, const char *studentID, const char *text, size_t length)
+{
+    // 日志已无法写入时退出会完整保存，不再记录
+    if (journalDisabled)
+        return;
+
+#ifndef _WIN32
+    if (startAutosave())
+    {
+        pthread_mutex_lock(&autosaveMutex);
+        bool failed = autosaveFailed;
+        bool queued = !failed && addPendingRecord(type, studentID, text, length);
+        if (queued && pendingCount >= runtimeOptions.autosaveChanges)
+            pthread_cond_signal(&autosaveWake);
+        pthread_mutex_unlock(&autosaveMutex);
+
+        if (!queued)
+            journalWriteFailed();
+        return;
+    }
+#else
+    (void)studentID;
+#endif
+
+    if (!appendJournalRecord(type, text, length))
+        journalWriteFailed();
+}
+
+/**
+ * @brief 记录学生的新增或修改
+ * @details 把学生的完整数据行交给自动保存线程写入变更日志；没有自动保存线程时直接追加，需要时按批量调用fsync
+ * @param student 学生记录（必须是学生数组中的有效记录）
+ * @note 日志无法写入时输出警告并设置dataModified，退出时改为完整保存CSV文件
+ */
+void journalStudentSaved(const Student *student)
+{
+    char record[STUDENT_RECORD_TEXT_SIZE];
+    size_t length = formatStudentRecord(record, sizeof(record), student, getStudentDetail(student));
+    if (length == 0)
+    {
+        journalWriteFailed();
+        return;
+    }
+    recordJournalChange(JOURNAL_RECORD_UPSERT, student->studentID, record, length);
+}
+
+/**
+ * @brief 记录学生的删除
+ * @param studentID 被删除学生的学号
+ * @note 日志无法写入时输出警告并设置dataModified，退出时改为完整保存CSV文件
+ */
+void journalStudentRemoved(const char *studentID)
+{
+    recordJournalChange(JOURNAL_RECORD_DELETE, studentID, studentID, strlen(studentID));
+}
+
+/**
+ * @brief 写完待写入的变更并停止自动保存线程
+ * @details 通知自动保存线程写入剩余的变更后退出，并等待它结束；之后的变更直接追加到日志
+ * @note 在退出时保存数据之前调用；后台写入失败时输出警告并设置dataModified
+ */
+void flushStudentJournal()
+{
+#ifndef _WIN32
+    if (!autosaveRunning)
+    {
+        autosaveStopping = true;
+        return;
+    }
+
+    pthread_mutex_lock(&autosaveMutex);
+    autosaveStopping = true;
+    pthread_cond_signal(&autosaveWake);
+    pthread_mutex_unlock(&autosaveMutex);
+    pthread_join(autosaveThread, NULL);
+    autosaveRunning = false;
+
+    free(pendingRecords);
+    pendingRecords = NULL;
+    pendingCount = 0;
+    pendingCapacity = 0;
+    if (autosaveFailed)
+        journalWriteFailed();
+#endif
+}
+
+/**
+ * @brief 把变更日志写入磁盘
+ * @details 对尚未同步的记录调用一次fsync
+ * @return 成功（或没有待同步的记录）返回true，否则返回false
+ * @note 自动保存线程运行时由该线程调用
+ */
+bool syncStudentJournal()
+{
+    if (journalFile == NULL || unsyncedRecords == 0)
+        return true;
+
+    if (!syncFile(journalFile))
+        return false;
+    unsyncedRecords = 0;
+    lastSyncTime = getCurrentTimeSeconds();
+    return true;
+}
+
+/**
+ * @brief 判断变更日志是否需要压缩
+ * @return 日志记录数达到runtimeOptions.compactRecords时返回true
+ * @note 压缩即调用saveStudentsToFile()完整保存，保存成功后日志被清空；应在flushStudentJournal()之后调用
+ */
+bool studentJournalNeedsCompaction()
+{
+    return journalRecords > 0 && journalRecords >= runtimeOptions.compactRecords;
+}
+
+/**
+ * @brief 清空变更日志
+ * @details 先写完待写入的变更，再关闭并删除STUDENTS_JOURNAL_FILE；删除之前先同步CSV文件所在的目录
+ * @note 由saveStudentsToFile()在CSV文件保存成功后调用
+ */
+void resetStudentJournal()
+{
+    flushStudentJournal();
+    if (journalFile != NULL)
+    {
+        fclose(journalFile);
+        journalFile = NULL;
+    }
+
+    // 日志删除之前，替换CSV文件的重命名必须先写入磁盘，否则断电后可能两者都丢失
+    if (fileExists(STUDENTS_JOURNAL_FILE))
+    {
+        syncPendingDirectory();
+        remove(STUDENTS_JOURNAL_FILE);
+    }
+    journalRecords = 0;
+    unsyncedRecords = 0;
+    journalDisabled = false;
+}
+
+/**
+ * @brief 关闭变更日志
+ * @details 写完待写入的变更，同步尚未写入磁盘的记录并关闭文件，在系统退出时调用
+ */
+void closeStudentJournal()
+{
+    flushStudentJournal();
+    if (journalFile == NULL)
+        return;
+
+    if (!syncStudentJournal())
+    {
+        printWarning("变更日志未能写入磁盘");
+    }
+    fclose(journalFile);
+    journalFile = NULL;
+}
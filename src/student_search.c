@@ -10,6 +10,10 @@
 #include "config.h"
 #include "globals.h"
 #include "io_utils.h"
+#include "math_utils.h"
+#include "course_dict.h"
+#include "student_id.h"
+#include "student_store.h"
 
 // 函数前向声明
 void displayStudentInfo(const Student *student);
@@ -85,7 +89,7 @@ void searchStudentByName()
     bool found = false;
     for (int i = 0; i < studentCount; i++)
     {
-        if (strstr(students[i].name, name) != NULL)
+        if (strstr(getStudentDetail(&students[i])->name, name) != NULL)
         {
             if (!found)
             {
@@ -137,11 +141,11 @@ void displayAllStudents()
     {
         printf("%-10s %-10s %-4d %-4c %-8.2f %-8.2f\n",
                students[i].studentID,
-               students[i].name,
+               getStudentDetail(&students[i])->name,
                students[i].age,
                students[i].gender,
-               students[i].totalScore,
-               students[i].averageScore);
+               scoreToFloat(students[i].totalScore),
+               scoreToFloat(students[i].averageScore));
     }
 
     printf("\n总学生数: %d\n", studentCount);
@@ -151,7 +155,7 @@ void displayAllStudents()
 /**
  * @brief 显示单个学生详细信息
  * @details 显示指定学生的完整详细信息，包括基本信息和所有课程成绩
- * @param student 指向要显示信息的学生结构体的常量指针
+ * @param student 指向要显示信息的学生结构体的常量指针（学生数组中的记录，详细信息通过句柄获取）
  * @note 显示内容：
  *       - 基本信息：学号、姓名、年龄、性别、课程数量
  *       - 课程成绩：每门课程的名称和分数
@@ -160,25 +164,27 @@ void displayAllStudents()
  */
 void displayStudentInfo(const Student *student)
 {
+    const StudentDetail *detail = getStudentDetail(student);
+
     printf("\n学生详细信息：\n");
     printSeparator();
     printf("学号: %s\n", student->studentID);
-    printf("姓名: %s\n", student->name);
+    printf("姓名: %s\n", detail->name);
     printf("年龄: %d\n", student->age);
     printf("性别: %c\n", student->gender);
-    printf("课程数量: %d\n", student->courseCount);
+    printf("课程数量: %d\n", detail->courseCount);
 
-    if (student->courseCount > 0)
+    if (detail->courseCount > 0)
     {
         printf("\n课程成绩：\n");
-        for (int i = 0; i < student->courseCount; i++)
+        for (int i = 0; i < detail->courseCount; i++)
         {
             printf("  %s: %.2f分\n",
-                   student->courses[i],
-                   student->scores[i]);
+                   getCourseName(detail->courseIds[i]),
+                   scoreToFloat(detail->scores[i]));
         }
-        printf("\n总分: %.2f\n", student->totalScore);
-        printf("平均分: %.2f\n", student->averageScore);
+        printf("\n总分: %.2f\n", scoreToFloat(student->totalScore));
+        printf("平均分: %.2f\n", scoreToFloat(student->averageScore));
     }
 }
 
@@ -194,7 +200,8 @@ static void ensureSortedByID()
     bool isSorted = true;
     for (int i = 0; i < studentCount - 1; i++)
     {
-        if (strcmp(students[i].studentID, students[i + 1].studentID) > 0)
+        if (compareStudentID(students[i].idKey, students[i].studentID,
+                             students[i + 1].idKey, students[i + 1].studentID) > 0)
         {
             isSorted = false;
             break;
@@ -217,16 +224,18 @@ static void ensureSortedByID()
  * @param studentID 要查找的学号
  * @return 找到的学生索引，如果未找到返回-1
  * @note 要求学生数组必须按学号排序
+ * @note 查询学号只编码一次，数字学号的每次比较都是一次整数比较
  */
 static int binarySearchByID(const char *studentID)
 {
+    uint64_t key = encodeStudentID(studentID);
     int left = 0;
     int right = studentCount - 1;
     
     while (left <= right)
     {
         int mid = left + (right - left) / 2;
-        int cmp = strcmp(students[mid].studentID, studentID);
+        int cmp = compareStudentID(students[mid].idKey, students[mid].studentID, key, studentID);
         
         if (cmp == 0)
         {
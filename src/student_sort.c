@@ -9,6 +9,8 @@
 #include <string.h>
 #include "config.h"
 #include "globals.h"
+#include "student_store.h"
+#include "student_id.h"
 
 /**
  * @brief 比较函数 - 按学号排序
@@ -20,7 +22,8 @@ static int compareByID(const void *a, const void *b)
 {
     const Student *studentA = (const Student *)a;
     const Student *studentB = (const Student *)b;
-    int result = strcmp(studentA->studentID, studentB->studentID);
+    int result = compareStudentID(studentA->idKey, studentA->studentID,
+                                  studentB->idKey, studentB->studentID);
     return (currentSortOrder == SORT_ASCENDING) ? result : -result;
 }
 
@@ -34,7 +37,7 @@ static int compareByName(const void *a, const void *b)
 {
     const Student *studentA = (const Student *)a;
     const Student *studentB = (const Student *)b;
-    int result = strcmp(studentA->name, studentB->name);
+    int result = strcmp(getStudentDetail(studentA)->name, getStudentDetail(studentB)->name);
     return (currentSortOrder == SORT_ASCENDING) ? result : -result;
 }
 
@@ -116,5 +119,8 @@ void sortStudents(int criteria, int order)
         return; // 无效的排序依据
     }
 
+    // 学生数组已重排，槽位表和列式视图需按新顺序更新（句柄随记录移动，缓存仍然有效）
+    refreshStudentIndex();
+
     dataModified = true;
 }
\ No newline at end of file
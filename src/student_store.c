@@ -0,0 +1,735 @@
+/**
+ * @file student_store.c
+ * @brief 学生动态存储容器实现
+ * @note 负责学生数组的内存分配，容量按需倍增，上限仅受可用内存限制
+ *       同时维护与学生数组同步的成绩列式视图studentColumns，
+ *       以及把稳定句柄映射到数组下标的槽位表（slot map）
+ *       学生记录分为热数据（students数组）和冷数据（按槽位分页存放的StudentDetail）
+ *       延迟加载的记录只保存源数据位置，详细信息在首次访问时才解码
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "student_store.h"
+#include "config.h"
+#include "globals.h"
+#include "student_id.h"
+
+// 每页详细信息的槽位数，页按需分配，已分配的页地址不随扩容变化
+#define DETAIL_PAGE_SIZE 256
+
+// 详细信息已在内存中（不需要解码）的源数据位置标记
+#define DETAIL_SOURCE_RESIDENT UINT64_MAX
+
+/**
+ * @brief 槽位表项
+ * @note 占用中的槽位记录学生在数组中的下标，空闲槽位通过nextFree串成空闲链表
+ */
+typedef struct {
+    int denseIndex;         // 学生数组下标，空闲时为-1
+    uint32_t generation;    // 槽位代数，每次释放时递增
+    int nextFree;           // 下一个空闲槽位，-1表示链表结束
+} StudentSlot;
+
+static StudentSlot *slots = NULL;   // 槽位表
+static int slotCount = 0;           // 已使用过的槽位数
+static int slotCapacity = 0;        // 槽位表容量
+static int freeSlotHead = -1;       // 空闲槽位链表头
+
+// 学生详细信息（冷数据）页表，第slot个槽位位于detailPages[slot / DETAIL_PAGE_SIZE]
+static StudentDetail **detailPages = NULL;
+static int detailPageCount = 0;     // 页表容量
+
+// 延迟加载时各槽位详细信息的源数据位置，没有延迟加载的记录时为NULL
+static uint64_t *detailSources = NULL;
+static StudentDetailLoader detailLoader = NULL;
+
+// 详细信息无法分配或解码时返回的空记录
+static StudentDetail unavailableDetail;
+
+// 列式视图中的课程编号和成绩列尚未填充（按列投影只加载统计字段时）
+static bool courseColumnsPending = false;
+
+/**
+ * @brief 扩大详细信息页表和源数据位置表
+ * @param newSlotCapacity 新的槽位容量
+ * @return 成功返回true，内存不足返回false
+ */
+static bool growDetailTables(int newSlotCapacity)
+{
+    int pageCount = (newSlotCapacity + DETAIL_PAGE_SIZE - 1) / DETAIL_PAGE_SIZE;
+    if (pageCount > detailPageCount)
+    {
+        StudentDetail **grownPages = realloc(detailPages, (size_t)pageCount * sizeof(StudentDetail *));
+        if (grownPages == NULL)
+            return false;
+        memset(grownPages + detailPageCount, 0, (size_t)(pageCount - detailPageCount) * sizeof(StudentDetail *));
+        detailPages = grownPages;
+        detailPageCount = pageCount;
+    }
+
+    if (detailSources != NULL)
+    {
+        uint64_t *grownSources = realloc(detailSources, (size_t)newSlotCapacity * sizeof(uint64_t));
+        if (grownSources == NULL)
+            return false;
+        for (int slot = slotCapacity; slot < newSlotCapacity; slot++)
+        {
+            grownSources[slot] = DETAIL_SOURCE_RESIDENT;
+        }
+        detailSources = grownSources;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 获取槽位的详细信息存放位置
+ * @param slot 槽位下标
+ * @return 详细信息位置，所在页分配失败时返回NULL
+ */
+static StudentDetail *detailSlot(int slot)
+{
+    StudentDetail **page = &detailPages[slot / DETAIL_PAGE_SIZE];
+    if (*page == NULL)
+    {
+        *page = malloc(DETAIL_PAGE_SIZE * sizeof(StudentDetail));
+        if (*page == NULL)
+            return NULL;
+    }
+    return &(*page)[slot % DETAIL_PAGE_SIZE];
+}
+
+/**
+ * @brief 查看下一次分配将使用的槽位
+ * @details 优先使用空闲槽位，否则使用槽位表末尾的新槽位，必要时扩容槽位表和详细信息数组
+ * @return 槽位下标，内存不足时返回-1
+ * @note 只预留不占用，槽位在allocateStudentHandle()中真正分配
+ */
+static int peekFreeSlot()
+{
+    if (freeSlotHead >= 0)
+        return freeSlotHead;
+
+    if (slotCount == slotCapacity)
+    {
+        int newCapacity = slotCapacity == 0 ? INITIAL_STUDENT_CAPACITY : slotCapacity * 2;
+        StudentSlot *grownSlots = realloc(slots, (size_t)newCapacity * sizeof(StudentSlot));
+        if (grownSlots == NULL)
+            return -1;
+        slots = grownSlots;
+
+        if (!growDetailTables(newCapacity))
+            return -1;
+        slotCapacity = newCapacity;
+    }
+
+    return slotCount;
+}
+
+/**
+ * @brief 为指定下标的学生分配句柄
+ * @details 优先复用空闲槽位，否则在槽位表末尾追加
+ * @param index 学生数组下标
+ * @return 分配成功返回true，内存不足返回false
+ */
+static bool allocateStudentHandle(int index)
+{
+    int slot = peekFreeSlot();
+    if (slot < 0)
+        return false;
+
+    if (slot == freeSlotHead)
+    {
+        freeSlotHead = slots[slot].nextFree;
+    }
+    else
+    {
+        slotCount++;
+        slots[slot].generation = 1;
+    }
+
+    slots[slot].denseIndex = index;
+    slots[slot].nextFree = -1;
+    students[index].handle.slot = (uint32_t)slot;
+    students[index].handle.generation = slots[slot].generation;
+    return true;
+}
+
+/**
+ * @brief 释放学生句柄
+ * @details 槽位代数递增使旧句柄失效，并把槽位放回空闲链表
+ * @param handle 要释放的句柄
+ */
+static void releaseStudentHandle(StudentHandle handle)
+{
+    StudentSlot *entry = &slots[handle.slot];
+    entry->denseIndex = -1;
+    entry->generation++;
+    if (entry->generation == 0)
+        entry->generation = 1; // 跳过表示无效句柄的0
+    entry->nextFree = freeSlotHead;
+    freeSlotHead = (int)handle.slot;
+}
+
+/**
+ * @brief 填充单个学生的列式视图
+ * @param index 学生下标
+ * @param student 学生记录
+ * @param detail 学生详细信息
+ */
+static void fillStudentColumns(int index, const Student *student, const StudentDetail *detail)
+{
+    StudentColumns *columns = &studentColumns;
+
+    columns->averageScore[index] = student->averageScore;
+    columns->totalScore[index] = student->totalScore;
+    columns->age[index] = student->age;
+    columns->gender[index] = student->gender;
+    columns->courseCount[index] = (unsigned char)detail->courseCount;
+    for (int j = 0; j < MAX_COURSES; j++)
+    {
+        bool used = j < detail->courseCount;
+        columns->courseIds[j][index] = used ? detail->courseIds[j] : 0;
+        columns->courseScores[j][index] = used ? detail->scores[j] : 0;
+    }
+}
+
+/**
+ * @brief 按新顺序重排单个列数组
+ * @param column 列数组
+ * @param elementSize 元素大小（1、2或4字节）
+ * @param order order[i]为新位置i上的记录原来的下标
+ * @param scratch 临时缓冲区，至少studentCount * 4字节
+ */
+static void permuteColumn(void *column, size_t elementSize, const int *order, void *scratch)
+{
+    switch (elementSize)
+    {
+    case 1:
+        for (int i = 0; i < studentCount; i++)
+            ((uint8_t *)scratch)[i] = ((const uint8_t *)column)[order[i]];
+        break;
+    case 2:
+        for (int i = 0; i < studentCount; i++)
+            ((uint16_t *)scratch)[i] = ((const uint16_t *)column)[order[i]];
+        break;
+    default:
+        for (int i = 0; i < studentCount; i++)
+            ((uint32_t *)scratch)[i] = ((const uint32_t *)column)[order[i]];
+        break;
+    }
+    memcpy(column, scratch, (size_t)studentCount * elementSize);
+}
+
+/**
+ * @brief 重新分配单个列数组
+ * @param column 指向列数组指针的指针
+ * @param elementSize 元素大小
+ * @param newCapacity 新容量
+ * @return 分配成功返回true，否则返回false（原数组保持不变）
+ */
+static bool resizeColumn(void **column, size_t elementSize, int newCapacity)
+{
+    void *grown = realloc(*column, (size_t)newCapacity * elementSize);
+    if (grown == NULL)
+        return false;
+
+    *column = grown;
+    return true;
+}
+
+/**
+ * @brief 重新分配成绩列式视图
+ * @details 将所有列数组调整为newCapacity个元素的大小
+ * @param newCapacity 新容量
+ * @return 全部分配成功返回true；失败时已调整的列仍然有效，容量记为调整前后的较小值
+ */
+static bool resizeStudentColumns(int newCapacity)
+{
+    StudentColumns *columns = &studentColumns;
+    bool ok = resizeColumn((void **)&columns->averageScore, sizeof(Score), newCapacity) &&
+              resizeColumn((void **)&columns->totalScore, sizeof(ScoreTotal), newCapacity) &&
+              resizeColumn((void **)&columns->age, sizeof(int), newCapacity) &&
+              resizeColumn((void **)&columns->gender, sizeof(char), newCapacity) &&
+              resizeColumn((void **)&columns->courseCount, sizeof(unsigned char), newCapacity);
+
+    for (int j = 0; ok && j < MAX_COURSES; j++)
+    {
+        ok = resizeColumn((void **)&columns->courseIds[j], sizeof(CourseId), newCapacity) &&
+             resizeColumn((void **)&columns->courseScores[j], sizeof(Score), newCapacity);
+    }
+
+    // 失败时各列可能大小不一，只有较小的容量对所有列都成立
+    if (ok || newCapacity < columns->capacity)
+        columns->capacity = newCapacity;
+    return ok;
+}
+
+/**
+ * @brief 重新分配学生数组
+ * @details 将学生数组调整为newCapacity个记录的大小
+ * @param newCapacity 新容量
+ * @return 分配成功返回true，否则返回false（原数组保持不变）
+ */
+static bool resizeStudentStore(int newCapacity)
+{
+    if (newCapacity <= 0 || (size_t)newCapacity > SIZE_MAX / sizeof(Student))
+        return false;
+
+    // 列容量始终不小于学生数组容量：扩容时先扩列式视图
+    if (newCapacity > studentCapacity && !resizeStudentColumns(newCapacity))
+        return false;
+
+    Student *newStudents = realloc(students, (size_t)newCapacity * sizeof(Student));
+    if (newStudents == NULL)
+        return false;
+
+    students = newStudents;
+    studentCapacity = newCapacity;
+
+    // 收缩时学生数组收缩成功后再收缩列式视图，列收缩失败只是少释放内存
+    if (newCapacity < studentColumns.capacity)
+        resizeStudentColumns(newCapacity);
+    return true;
+}
+
+/**
+ * @brief 预留学生存储容量
+ * @details 将学生数组的容量调整为至少capacity个记录，已有数据保持不变
+ * @param capacity 期望的最小容量
+ * @return 如果容量已满足或扩容成功返回true，内存不足时返回false
+ * @note 容量只增不减，需要收缩请调用shrinkStudentStore()
+ */
+bool reserveStudents(int capacity)
+{
+    if (capacity <= studentCapacity)
+        return true;
+
+    return resizeStudentStore(capacity);
+}
+
+/**
+ * @brief 确保学生数组可以再容纳一条记录
+ * @details 当数组已满时按倍增策略扩容（初始容量为INITIAL_STUDENT_CAPACITY）
+ * @return 如果有空闲位置返回true，内存不足时返回false
+ * @note 倍增扩容使追加操作的均摊时间复杂度为O(1)
+ */
+bool ensureStudentCapacity()
+{
+    if (studentCount < studentCapacity)
+        return true;
+
+    int newCapacity;
+    if (studentCapacity == 0)
+        newCapacity = INITIAL_STUDENT_CAPACITY;
+    else if (studentCapacity > INT_MAX / 2)
+        newCapacity = INT_MAX;
+    else
+        newCapacity = studentCapacity * 2;
+
+    if (newCapacity <= studentCount)
+        return false; // 已达int可表示的上限
+
+    return resizeStudentStore(newCapacity);
+}
+
+/**
+ * @brief 开始原地追加学生记录
+ * @details 确保容量后返回数组末尾的空闲位置和对应的详细信息位置，调用者可直接在其中填充数据
+ * @param detail 输出参数，指向新记录详细信息（冷数据）的空闲位置
+ * @return 指向空闲位置的指针，内存不足时返回NULL
+ * @note 填充完成后调用commitAppendStudent()使记录生效；不提交则该位置被下次追加覆盖
+ */
+Student *beginAppendStudent(StudentDetail **detail)
+{
+    if (!ensureStudentCapacity())
+        return NULL;
+
+    int slot = peekFreeSlot();
+    if (slot < 0)
+        return NULL;
+
+    *detail = detailSlot(slot);
+    if (*detail == NULL)
+        return NULL;
+    return &students[studentCount];
+}
+
+/**
+ * @brief 提交原地追加的学生记录
+ * @details 为beginAppendStudent()返回位置上的记录计算学号编码键、分配句柄、同步列式视图并计入学生数量
+ * @return 成功返回true，句柄分配失败（内存不足）返回false
+ */
+bool commitAppendStudent()
+{
+    if (studentCount >= studentCapacity || !allocateStudentHandle(studentCount))
+        return false;
+
+    students[studentCount].idKey = encodeStudentID(students[studentCount].studentID);
+    if (detailSources != NULL)
+        detailSources[students[studentCount].handle.slot] = DETAIL_SOURCE_RESIDENT;
+
+    syncStudentColumns(studentCount);
+    studentCount++;
+    return true;
+}
+
+/**
+ * @brief 追加详细信息延迟解码的学生记录
+ * @details 与appendStudent()相同，但只用detail填充列式视图，不保存详细信息本身，
+ *          而是记录其源数据位置，首次通过getStudentDetail()访问时再由解码函数读取
+ * @param student 要追加的学生记录（其中的handle和idKey字段会被覆盖）
+ * @param detail 学生详细信息，只用于填充列式视图，调用后即可丢弃
+ * @param source 详细信息的源数据位置，传给setStudentDetailLoader()设置的解码函数
+ * @return 成功返回true，内存不足返回false
+ */
+bool appendDeferredStudent(const Student *student, const StudentDetail *detail, uint64_t source)
+{
+    if (!ensureStudentCapacity() || peekFreeSlot() < 0)
+        return false;
+
+    if (detailSources == NULL)
+    {
+        detailSources = malloc((size_t)slotCapacity * sizeof(uint64_t));
+        if (detailSources == NULL)
+            return false;
+        for (int slot = 0; slot < slotCapacity; slot++)
+        {
+            detailSources[slot] = DETAIL_SOURCE_RESIDENT;
+        }
+    }
+
+    students[studentCount] = *student;
+    if (!allocateStudentHandle(studentCount))
+        return false;
+
+    students[studentCount].idKey = encodeStudentID(students[studentCount].studentID);
+    detailSources[students[studentCount].handle.slot] = source;
+
+    fillStudentColumns(studentCount, &students[studentCount], detail);
+    studentCount++;
+    return true;
+}
+
+/**
+ * @brief 追加学生记录
+ * @details 将学生记录复制到学生数组末尾，必要时自动扩容，并为其分配新的句柄
+ * @param student 要追加的学生记录（其中的handle和idKey字段会被覆盖）
+ * @param detail 学生详细信息
+ * @return 指向数组中新记录的指针，内存不足时返回NULL
+ * @warning 扩容后之前获取的学生指针可能失效
+ */
+Student *appendStudent(const Student *student, const StudentDetail *detail)
+{
+    StudentDetail *slotDetail;
+    Student *slot = beginAppendStudent(&slotDetail);
+    if (slot == NULL)
+        return NULL;
+
+    *slot = *student;
+    *slotDetail = *detail;
+    if (!commitAppendStudent())
+        return NULL;
+    return slot;
+}
+
+/**
+ * @brief 删除指定位置的学生记录
+ * @details 删除index处的记录，后续记录整体前移以保持原有顺序
+ *          被删除记录的句柄失效，其他记录的句柄保持有效
+ * @param index 要删除的记录下标
+ * @note 如果下标无效，函数不做任何操作
+ */
+void removeStudentAt(int index)
+{
+    if (index < 0 || index >= studentCount)
+        return;
+
+    releaseStudentHandle(students[index].handle);
+
+    size_t tail = (size_t)(studentCount - index - 1);
+    memmove(&students[index], &students[index + 1], tail * sizeof(Student));
+
+    // 前移的记录下标减一，句柄本身保持不变
+    for (int i = index; i < studentCount - 1; i++)
+    {
+        slots[students[i].handle.slot].denseIndex = i;
+    }
+
+    // 列式视图同步前移
+    StudentColumns *columns = &studentColumns;
+    memmove(&columns->averageScore[index], &columns->averageScore[index + 1], tail * sizeof(Score));
+    memmove(&columns->totalScore[index], &columns->totalScore[index + 1], tail * sizeof(ScoreTotal));
+    memmove(&columns->age[index], &columns->age[index + 1], tail * sizeof(int));
+    memmove(&columns->gender[index], &columns->gender[index + 1], tail * sizeof(char));
+    memmove(&columns->courseCount[index], &columns->courseCount[index + 1], tail * sizeof(unsigned char));
+    for (int j = 0; j < MAX_COURSES; j++)
+    {
+        memmove(&columns->courseIds[j][index], &columns->courseIds[j][index + 1], tail * sizeof(CourseId));
+        memmove(&columns->courseScores[j][index], &columns->courseScores[j][index + 1], tail * sizeof(Score));
+    }
+
+    studentCount--;
+}
+
+/**
+ * @brief 收缩学生存储容量
+ * @details 将容量收缩到当前记录数（不少于INITIAL_STUDENT_CAPACITY），释放多余内存
+ * @note 通常在批量加载完成后调用，使内存占用与实际记录数一致
+ */
+void shrinkStudentStore()
+{
+    int target = studentCount > INITIAL_STUDENT_CAPACITY ? studentCount : INITIAL_STUDENT_CAPACITY;
+    if (students == NULL || target >= studentCapacity)
+        return;
+
+    // 收缩失败时保留原数组即可，不影响数据
+    resizeStudentStore(target);
+}
+
+/**
+ * @brief 同步单个学生的列式视图
+ * @details 将students[index]及其详细信息中统计相关的字段复制到studentColumns对应位置
+ * @param index 学生下标
+ * @note 原地修改学生记录后必须调用，否则统计结果会使用旧数据
+ */
+void syncStudentColumns(int index)
+{
+    if (index < 0 || index >= studentColumns.capacity)
+        return;
+
+    fillStudentColumns(index, &students[index], getStudentDetail(&students[index]));
+}
+
+/**
+ * @brief 学生数组整体重排后更新索引
+ * @details 按学生数组的当前顺序重排studentColumns，并更新槽位表中的下标
+ * @note 在整体重排（如排序）后调用；句柄随记录一起移动，因此重排后依然有效
+ * @note 列按槽位表中的原下标搬移，不访问详细信息，延迟加载的记录不会因排序而被解码
+ */
+void refreshStudentIndex()
+{
+    // 槽位表此时仍记录着重排前的下标
+    int *order = malloc((size_t)(studentCount > 0 ? studentCount : 1) * sizeof(int));
+    uint32_t *scratch = malloc((size_t)(studentCount > 0 ? studentCount : 1) * sizeof(uint32_t));
+    if (order == NULL || scratch == NULL)
+    {
+        // 内存不足时退回到从详细信息逐条重建
+        free(order);
+        free(scratch);
+        for (int i = 0; i < studentCount; i++)
+        {
+            slots[students[i].handle.slot].denseIndex = i;
+            syncStudentColumns(i);
+        }
+        return;
+    }
+
+    for (int i = 0; i < studentCount; i++)
+    {
+        order[i] = slots[students[i].handle.slot].denseIndex;
+    }
+
+    StudentColumns *columns = &studentColumns;
+    permuteColumn(columns->averageScore, sizeof(Score), order, scratch);
+    permuteColumn(columns->totalScore, sizeof(ScoreTotal), order, scratch);
+    permuteColumn(columns->age, sizeof(int), order, scratch);
+    permuteColumn(columns->gender, sizeof(char), order, scratch);
+    permuteColumn(columns->courseCount, sizeof(unsigned char), order, scratch);
+    for (int j = 0; j < MAX_COURSES; j++)
+    {
+        permuteColumn(columns->courseIds[j], sizeof(CourseId), order, scratch);
+        permuteColumn(columns->courseScores[j], sizeof(Score), order, scratch);
+    }
+
+    for (int i = 0; i < studentCount; i++)
+    {
+        slots[students[i].handle.slot].denseIndex = i;
+    }
+
+    free(order);
+    free(scratch);
+}
+
+/**
+ * @brief 解析学生句柄
+ * @details 通过槽位表把句柄转换为学生数组的当前下标
+ * @param handle 学生句柄
+ * @return 学生数组下标，句柄无效或记录已删除时返回-1
+ * @note 时间复杂度O(1)
+ */
+int resolveStudentHandle(StudentHandle handle)
+{
+    if (handle.generation == 0 || handle.slot >= (uint32_t)slotCount)
+        return -1;
+
+    const StudentSlot *entry = &slots[handle.slot];
+    if (entry->generation != handle.generation)
+        return -1;
+
+    return entry->denseIndex;
+}
+
+/**
+ * @brief 解码延迟加载的详细信息
+ * @param slot 槽位下标
+ * @return 解码后的详细信息；内存不足时返回unavailableDetail
+ * @note 解码失败时记录按空的详细信息处理，之后不再重试
+ */
+static StudentDetail *materializeDetail(int slot)
+{
+    StudentDetail *detail = detailSlot(slot);
+    if (detail == NULL)
+        return &unavailableDetail;
+
+    if (detailSources != NULL && detailSources[slot] != DETAIL_SOURCE_RESIDENT)
+    {
+        if (detailLoader == NULL || !detailLoader(detailSources[slot], detail))
+            memset(detail, 0, sizeof(StudentDetail));
+        detailSources[slot] = DETAIL_SOURCE_RESIDENT;
+    }
+    return detail;
+}
+
+/**
+ * @brief 获取学生详细信息
+ * @details 根据学生记录中的句柄槽位定位其详细信息（姓名、课程和成绩）
+ *          延迟加载的记录在首次访问时由解码函数从源数据中读取
+ * @param student 学生记录（必须是学生数组中的有效记录）
+ * @return 指向详细信息的指针
+ * @note 详细信息按槽位分页存放，学生排序、删除或新增后指针依然有效
+ * @warning 首次访问延迟加载的记录会修改存储，不能与其他线程并发调用
+ */
+StudentDetail *getStudentDetail(const Student *student)
+{
+    int slot = (int)student->handle.slot;
+    StudentDetail *page = detailPages[slot / DETAIL_PAGE_SIZE];
+    if (page != NULL && (detailSources == NULL || detailSources[slot] == DETAIL_SOURCE_RESIDENT))
+        return &page[slot % DETAIL_PAGE_SIZE];
+
+    return materializeDetail(slot);
+}
+
+/**
+ * @brief 设置详细信息解码函数
+ * @param loader 解码函数，用于appendDeferredStudent()追加的记录；NULL表示取消
+ */
+void setStudentDetailLoader(StudentDetailLoader loader)
+{
+    detailLoader = loader;
+}
+
+/**
+ * @brief 解码全部延迟加载的详细信息
+ * @details 依次解码尚未访问过的记录，完成后不再需要源数据
+ * @return 全部解码成功（或没有延迟加载的记录）返回true，内存不足返回false
+ * @note 在源数据（如映射的CSV文件）失效之前调用，例如覆盖写入CSV文件之前
+ */
+bool materializeAllStudents()
+{
+    if (detailSources == NULL)
+        return true;
+
+    for (int i = 0; i < studentCount; i++)
+    {
+        if (getStudentDetail(&students[i]) == &unavailableDetail)
+            return false;
+    }
+
+    // 已删除记录留下的空闲槽位不再需要源数据位置
+    free(detailSources);
+    detailSources = NULL;
+    detailLoader = NULL;
+    return true;
+}
+
+/**
+ * @brief 标记课程列尚未填充
+ * @details 按列投影加载时没有解析各科课程和成绩，列式视图中的课程编号和成绩列为0，
+ *          在ensureCourseColumns()中解码全部记录后补齐
+ * @note 课程数量列不受影响，加载时已经解析
+ */
+void markCourseColumnsPending()
+{
+    courseColumnsPending = true;
+}
+
+/**
+ * @brief 确保列式视图中的课程列已填充
+ * @details 课程列被标记为尚未填充时，解码全部记录并按详细信息重新填充列式视图
+ * @return 课程列可用返回true，内存不足返回false
+ * @note 解码会在课程字典中登记新的课程，按课程编号分配数组之前调用
+ * @see markCourseColumnsPending()
+ */
+bool ensureCourseColumns()
+{
+    if (!courseColumnsPending)
+        return true;
+
+    for (int i = 0; i < studentCount; i++)
+    {
+        if (getStudentDetail(&students[i]) == &unavailableDetail)
+            return false;
+        syncStudentColumns(i);
+    }
+
+    courseColumnsPending = false;
+    return true;
+}
+
+/**
+ * @brief 通过句柄获取学生记录
+ * @param handle 学生句柄
+ * @return 指向学生记录的指针，句柄无效时返回NULL
+ * @warning 返回的指针在学生数组扩容、删除或排序后失效，需要长期引用时请保存句柄
+ */
+Student *getStudentByHandle(StudentHandle handle)
+{
+    int index = resolveStudentHandle(handle);
+    return index < 0 ? NULL : &students[index];
+}
+
+/**
+ * @brief 释放学生存储
+ * @details 释放学生数组、详细信息、列式视图和槽位表占用的全部内存，并将学生数量和容量清零
+ * @note 在系统退出时调用
+ */
+void freeStudentStore()
+{
+    StudentColumns *columns = &studentColumns;
+    free(columns->averageScore);
+    free(columns->totalScore);
+    free(columns->age);
+    free(columns->gender);
+    free(columns->courseCount);
+    for (int j = 0; j < MAX_COURSES; j++)
+    {
+        free(columns->courseIds[j]);
+        free(columns->courseScores[j]);
+    }
+    memset(columns, 0, sizeof(StudentColumns));
+
+    for (int page = 0; page < detailPageCount; page++)
+    {
+        free(detailPages[page]);
+    }
+    free(detailPages);
+    free(detailSources);
+    free(slots);
+    detailPages = NULL;
+    detailPageCount = 0;
+    detailSources = NULL;
+    detailLoader = NULL;
+    courseColumnsPending = false;
+    slots = NULL;
+    slotCount = 0;
+    slotCapacity = 0;
+    freeSlotHead = -1;
+
+    free(students);
+    students = NULL;
+    studentCount = 0;
+    studentCapacity = 0;
+}
@@ -6,6 +6,14 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <pthread.h>
+#endif
 #include "system_utils.h"
 #include "file_utils.h"
 #include "io_utils.h"
@@ -13,14 +21,271 @@
 #include "user_manage.h"
 #include "student_io.h"
 #include "statistical_analysis.h"
+#include "student_store.h"
+#include "course_dict.h"
+#include "student_heap.h"
+#include "student_journal.h"
+#include "globals.h"
+
+#ifndef _WIN32
+// 后台加载学生数据的线程状态，loaderFinished和loaderOutput受loaderMutex保护
+static pthread_t loaderThread;
+static pthread_mutex_t loaderMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t loaderDone = PTHREAD_COND_INITIALIZER;
+static bool loaderRunning = false;      // 加载线程已启动且尚未回收
+static bool loaderFinished = false;     // 加载线程已完成全部工作
+static FILE *loaderOutput = NULL;       // 加载期间暂存的消息
+#endif
+
+/**
+ * @brief 解析命令行选项
+ * @details 识别程序启动参数并写入runtimeOptions，目前支持：
+ *          --persist    创建二进制快照STUDENTS_HEAP_FILE，之后的启动默认从快照恢复数据
+ *          --threads=N  CSV加载和保存使用N个线程（1到MAX_LOAD_THREADS），默认按CPU核数自动选择
+ *          --lazy       延迟加载，姓名和课程明细在首次访问时才从CSV文件解码；本次运行不读写二进制快照
+ *          --columns=C  按列投影加载：scores跳过姓名，aggregates再跳过各科课程成绩，all解析全部字段；
+ *                       跳过的字段在首次访问时解码，因此同时启用--lazy
+ *          --compact=N  变更日志达到N条记录时，退出时完整保存CSV文件并清空日志；0表示每次退出都完整保存
+ *          --autosave=MS          后台自动保存线程每隔MS毫秒把变更写入日志；0表示不启动线程，每次变更直接写入
+ *          --autosave-changes=N   待写入的变更达到N条时立即自动保存
+ *          --sync-io    不使用io_uring，保存和流式读取改用pread/pwrite
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @note 应在initializeSystem()之前调用；无法识别的选项会输出警告并被忽略
+ */
+void parseCommandLineOptions(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--persist") == 0)
+        {
+            runtimeOptions.persistentHeap = true;
+        }
+        else if (strcmp(argv[i], "--lazy") == 0)
+        {
+            runtimeOptions.lazyLoad = true;
+        }
+        else if (strcmp(argv[i], "--sync-io") == 0)
+        {
+            runtimeOptions.syncIo = true;
+        }
+        else if (strncmp(argv[i], "--columns=", 10) == 0)
+        {
+            const char *columns = argv[i] + 10;
+            if (strcmp(columns, "all") == 0)
+            {
+                runtimeOptions.projection = LOAD_COLUMNS_ALL;
+            }
+            else if (strcmp(columns, "scores") == 0)
+            {
+                runtimeOptions.projection = LOAD_COLUMNS_SCORES;
+                runtimeOptions.lazyLoad = true;
+            }
+            else if (strcmp(columns, "aggregates") == 0)
+            {
+                runtimeOptions.projection = LOAD_COLUMNS_AGGREGATES;
+                runtimeOptions.lazyLoad = true;
+            }
+            else
+            {
+                printWarning("列投影无效，将解析全部字段：");
+                printf("%s\n", argv[i]);
+            }
+        }
+        else if (strncmp(argv[i], "--threads=", 10) == 0)
+        {
+            char *end;
+            long threads = strtol(argv[i] + 10, &end, 10);
+            if (end != argv[i] + 10 && *end == '\0' && threads >= 1 && threads <= MAX_LOAD_THREADS)
+            {
+                runtimeOptions.loadThreads = (int)threads;
+            }
+            else
+            {
+                printWarning("线程数无效，将按CPU核数自动选择：");
+                printf("%s\n", argv[i]);
+            }
+        }
+        else if (strncmp(argv[i], "--compact=", 10) == 0)
+        {
+            char *end;
+            long records = strtol(argv[i] + 10, &end, 10);
+            if (end != argv[i] + 10 && *end == '\0' && records >= 0 && records <= INT32_MAX)
+            {
+                runtimeOptions.compactRecords = (int)records;
+            }
+            else
+            {
+                printWarning("日志压缩阈值无效，将使用默认值：");
+                printf("%s\n", argv[i]);
+            }
+        }
+        else if (strncmp(argv[i], "--autosave=", 11) == 0)
+        {
+            char *end;
+            long interval = strtol(argv[i] + 11, &end, 10);
+            if (end != argv[i] + 11 && *end == '\0' && interval >= 0 && interval <= INT32_MAX)
+            {
+                runtimeOptions.autosaveIntervalMs = (int)interval;
+            }
+            else
+            {
+                printWarning("自动保存间隔无效，将使用默认值：");
+                printf("%s\n", argv[i]);
+            }
+        }
+        else if (strncmp(argv[i], "--autosave-changes=", 19) == 0)
+        {
+            char *end;
+            long changes = strtol(argv[i] + 19, &end, 10);
+            if (end != argv[i] + 19 && *end == '\0' && changes >= 1 && changes <= INT32_MAX)
+            {
+                runtimeOptions.autosaveChanges = (int)changes;
+            }
+            else
+            {
+                printWarning("自动保存变更数阈值无效，将使用默认值：");
+                printf("%s\n", argv[i]);
+            }
+        }
+        else
+        {
+            printWarning("忽略无法识别的选项：");
+            printf("%s\n", argv[i]);
+        }
+    }
+}
+
+/**
+ * @brief 加载学生数据
+ * @details 优先从二进制快照恢复，快照不可用或已过期时解析CSV并重建快照，
+ *          然后重放变更日志，最后初始化统计缓存
+ * @note 在后台加载线程中执行时，输出的消息先暂存，等待完成时再显示
+ */
+static void loadStudentData()
+{
+    if (runtimeOptions.persistentHeap && loadStudentHeap())
+    {
+        printInfo("已从二进制快照恢复学生数据");
+        fprintf(messageStream(), "学生数量：%d\n", studentCount);
+    }
+    else
+    {
+        loadStudentsFromFile();
+        if (runtimeOptions.persistentHeap && !saveStudentHeap())
+        {
+            printWarning("无法写入二进制快照，下次启动将重新解析CSV文件");
+        }
+    }
+
+    // 快照只反映CSV文件，之后的增删改从变更日志恢复
+    replayStudentJournal();
+    
+    // 初始化统计缓存
+    initStatisticsCache();
+}
+
+#ifndef _WIN32
+/**
+ * @brief 后台加载线程入口
+ * @details 加载学生数据，期间的消息暂存到临时文件，完成后通知等待的线程
+ * @param arg 未使用
+ * @return 总是返回NULL
+ */
+static void *studentLoaderMain(void *arg)
+{
+    (void)arg;
+    bool capturing = beginOutputCapture();
+    loadStudentData();
+    FILE *output = capturing ? endOutputCapture() : NULL;
+
+    pthread_mutex_lock(&loaderMutex);
+    loaderOutput = output;
+    loaderFinished = true;
+    pthread_cond_broadcast(&loaderDone);
+    pthread_mutex_unlock(&loaderMutex);
+    return NULL;
+}
+
+/**
+ * @brief 显示后台加载进度
+ * @details 在同一行刷新已解析的百分比；从快照恢复时没有字节进度，只显示提示
+ */
+static void showLoadProgress()
+{
+    size_t done, total;
+    getStudentLoadProgress(&done, &total);
+    if (total > 0)
+    {
+        printf("\r正在加载学生数据... %5.1f%%", (double)done * 100.0 / (double)total);
+    }
+    else
+    {
+        printf("\r正在加载学生数据...");
+    }
+    fflush(stdout);
+}
+
+/**
+ * @brief 等待后台加载线程结束并回收
+ * @param interactive 为true时显示加载进度和加载期间暂存的消息，为false时丢弃这些消息
+ */
+static void finishStudentLoading(bool interactive)
+{
+    if (!loaderRunning)
+        return;
+
+    bool showedProgress = false;
+    pthread_mutex_lock(&loaderMutex);
+    while (!loaderFinished)
+    {
+        if (interactive)
+        {
+            showLoadProgress();
+            showedProgress = true;
+        }
+
+        struct timespec deadline;
+        timespec_get(&deadline, TIME_UTC);
+        deadline.tv_nsec += LOAD_PROGRESS_INTERVAL_MS * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+            deadline.tv_nsec %= 1000000000L;
+        }
+        pthread_cond_timedwait(&loaderDone, &loaderMutex, &deadline);
+    }
+    FILE *output = loaderOutput;
+    loaderOutput = NULL;
+    pthread_mutex_unlock(&loaderMutex);
+
+    pthread_join(loaderThread, NULL);
+    loaderRunning = false;
+
+    if (showedProgress)
+    {
+        showLoadProgress();
+        printf("\n");
+    }
+    if (interactive)
+    {
+        replayCapturedOutput(output);
+    }
+    else if (output != NULL)
+    {
+        fclose(output);
+    }
+}
+#endif
 
 /**
  * @brief 初始化系统
- * @details 执行系统启动时的初始化操作，包括创建必要的数据目录
- *          调用createDataDirectories函数创建数据存储目录
+ * @details 执行系统启动时的初始化操作，包括创建必要的数据目录和加载用户数据
+ *          学生数据在后台线程中加载，登录流程无需等待解析完成
  * @return 如果初始化成功返回true，否则返回false
  * @note 此函数应在程序启动时调用
  * @note 如果初始化失败，会输出错误信息
+ * @note 访问学生数据之前必须先调用waitForStudentData()；无法创建线程时（或在Windows下）同步加载
  */
 bool initializeSystem()
 {
@@ -32,19 +297,51 @@ bool initializeSystem()
         return false;
     }
 
-    // 加载用户数据
+    // 加载用户数据（登录需要，仍同步加载）
     loadUsersFromFile();
     
-    // 加载学生数据
-    loadStudentsFromFile();
-    
-    // 初始化统计缓存
-    initStatisticsCache();
+    // 二进制快照一旦存在就作为默认的工作文件，CSV文件只用于人工编辑和导入导出
+    if (fileExists(STUDENTS_HEAP_FILE))
+    {
+        runtimeOptions.persistentHeap = true;
+    }
+
+    // 快照恢复全部详细信息，写入快照也要先解码全部记录，与延迟加载和列投影相抵触
+    if (runtimeOptions.persistentHeap && runtimeOptions.lazyLoad)
+    {
+        printWarning("延迟加载或列投影时不读写二进制快照，本次从CSV文件加载");
+        runtimeOptions.persistentHeap = false;
+    }
+
+    // 加载学生数据：在后台线程中进行，与登录流程并发
+#ifdef _WIN32
+    loadStudentData();
+#else
+    loaderFinished = false;
+    loaderRunning = pthread_create(&loaderThread, NULL, studentLoaderMain, NULL) == 0;
+    if (!loaderRunning)
+    {
+        loadStudentData();
+    }
+#endif
 
     printSuccess("系统初始化完成");
     return true;
 }
 
+/**
+ * @brief 等待学生数据加载完成
+ * @details 学生数据就绪的屏障：后台加载尚未完成时阻塞，并按LOAD_PROGRESS_INTERVAL_MS刷新加载进度，
+ *          完成后显示加载期间暂存的消息（加载吞吐量、格式错误等）
+ * @note 任何访问学生数据的操作之前都必须调用；已经就绪时立即返回，可以重复调用
+ */
+void waitForStudentData()
+{
+#ifndef _WIN32
+    finishStudentLoading(true);
+#endif
+}
+
 /**
  * @brief 创建数据目录
  * @details 创建程序运行所需的数据存储目录
@@ -68,13 +365,58 @@ bool createDataDirectories()
 /**
  * @brief 清理系统资源
  * @details 执行程序退出前的清理操作
- *          目前主要输出清理完成的提示信息
+ *          等待后台加载线程结束（丢弃其暂存的消息），再释放学生存储、统计缓存和课程字典占用的动态内存
  * @note 此函数应在程序退出前调用
  * @note 可以根据需要添加更多清理操作，如关闭文件、释放内存等
  */
 void cleanupSystem()
 {
     printInfo("正在清理系统资源...");
-    // 这里可以添加其他清理操作
+
+#ifndef _WIN32
+    // 登录失败退出时加载线程可能仍在运行，先等待它结束
+    finishStudentLoading(false);
+#endif
+
+    closeStudentJournal();
+    syncPendingDirectory();
+
+    // 释放学生存储和统计缓存
+    freeStudentStore();
+    releaseDeferredStudentSource();
+    freeStatisticsCache();
+    freeCourseDict();
     printSuccess("系统清理完成");
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 获取当前时间
+ * @details 基于C11的timespec_get()，精度为纳秒级，用于测量加载、保存等操作的耗时
+ * @return 以秒为单位的当前时间
+ * @note 只适合计算两次调用之间的时间差，不要用作日期
+ */
+double getCurrentTimeSeconds()
+{
+    struct timespec now;
+    if (timespec_get(&now, TIME_UTC) == 0)
+        return 0.0;
+
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief 获取可用的CPU核数
+ * @details Unix/Linux下使用sysconf查询在线处理器数量，Windows下使用GetSystemInfo
+ * @return CPU核数，查询失败时返回1
+ */
+int getProcessorCount()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
@@ -14,6 +14,7 @@
 #include "string_utils.h"
 #include "security_utils.h"
 #include "validation.h"
+#include "file_utils.h"
 
 /**
  * @brief 处理用户登录
@@ -128,11 +129,13 @@ void loadUsersFromFile()
  *          采用文本格式存储，每个用户占一行
  * @note 文件格式：每行格式为 "username:password:isAdmin"
  *       其中isAdmin为1表示管理员，0表示普通用户
+ * @note 先写入临时文件，fsync后重命名替换USERS_FILE，保存中途崩溃不会损坏原文件
  * @warning 如果文件无法打开，将显示错误信息
  */
 void saveUsersToFile()
 {
-    FILE *file = fopen(USERS_FILE, "w");
+    AtomicFile atomic;
+    FILE *file = openAtomicFile(&atomic, USERS_FILE, "w");
     if (file == NULL)
     {
         printError("无法保存用户数据！");
@@ -147,7 +150,10 @@ void saveUsersToFile()
                 users[i].isAdmin ? 1 : 0);
     }
 
-    fclose(file);
+    if (!commitAtomicFile(&atomic, true))
+    {
+        printError("无法保存用户数据！");
+    }
 }
 
 /**
@@ -14,13 +14,14 @@
 /**
  * @brief 验证成绩是否有效
  * @details 检查成绩是否在有效范围内（0-100分）
- * @param score 要验证的成绩值
+ * @param score 要验证的定点成绩（百分之一分）
  * @return 如果成绩有效返回true，否则返回false
- * @note 有效成绩范围为0.0到100.0（包含边界值）
+ * @note 有效成绩范围为0.00到100.00（包含边界值）
+ * @note 参数使用32位整数，以便在转换为Score之前检查解析结果
  */
-bool isValidScore(float score)
+bool isValidScore(int32_t score)
 {
-    return score >= 0.0 && score <= 100.0;
+    return score >= (int32_t)(MIN_SCORE * SCORE_SCALE) && score <= (int32_t)(MAX_SCORE * SCORE_SCALE);
 }
 
 /**